@@ -0,0 +1,290 @@
+// Bulk routines for solve bodies over integer arrays: radix_sort, prefix_sum, sum, min_value,
+// max_value. Each takes (pointer, n) or a container with data()/size(), so vector and
+// arena_vector both work. int and long long get AVX2 paths when the translation unit is
+// compiled with -mavx2 (or -march=native); everything has a scalar fallback.
+// Build with -DCP_PAR_UNSEQ (and -ltbb on libstdc++) to send inputs of PAR_MIN elements or
+// more through std::execution::par_unseq instead, for offline runs over large batches.
+// Everything lives in namespace cp, so a solution's own `sum` or `max_value` still compiles.
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <numeric>
+#include <type_traits>
+#include <vector>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+#ifdef CP_PAR_UNSEQ
+#include <execution>
+#endif
+
+namespace cp
+{
+
+const size_t PAR_MIN = 1 << 18; // Below this, threads cost more than they save
+
+// LSD radix sort on 11-bit digits (3 passes for 32-bit keys, 6 for 64-bit; 2048 counters
+// stay cache-resident). One pass builds every digit's histogram, and digits on which all
+// keys agree are skipped, so narrow value ranges sort in fewer passes.
+template <class T>
+void radix_sort(T *a, size_t n)
+{
+    static_assert(std::is_integral<T>::value && (sizeof(T) == 4 || sizeof(T) == 8), "radix_sort takes 32/64-bit integers");
+#ifdef CP_PAR_UNSEQ
+    if (n >= PAR_MIN) { std::sort(std::execution::par_unseq, a, a + n); return; }
+#endif
+    if (n < 256) { std::sort(a, a + n); return; }
+    typedef typename std::make_unsigned<T>::type U;
+    const int BITS = 11, R = 1 << BITS, D = (8 * sizeof(T) + BITS - 1) / BITS;
+    // Flipping the sign bit makes signed order match unsigned order
+    const U flip = std::is_signed<T>::value ? U(1) << (8 * sizeof(T) - 1) : 0;
+
+    std::vector<size_t> count(D * R, 0);
+    for (size_t i = 0; i < n; i++)
+    {
+        U k = U(a[i]) ^ flip;
+        for (int d = 0; d < D; d++) count[d * R + ((k >> (BITS * d)) & (R - 1))]++;
+    }
+    std::vector<T> tmp(n);
+    T *src = a, *dst = tmp.data();
+    for (int d = 0; d < D; d++)
+    {
+        size_t *c = &count[d * R];
+        int shift = BITS * d;
+        if (c[((U(src[0]) ^ flip) >> shift) & (R - 1)] == n) continue;
+        size_t offset = 0;
+        for (int b = 0; b < R; b++)
+        {
+            size_t k = c[b];
+            c[b] = offset;
+            offset += k;
+        }
+        for (size_t i = 0; i < n; i++) dst[c[((U(src[i]) ^ flip) >> shift) & (R - 1)]++] = src[i];
+        std::swap(src, dst);
+    }
+    if (src != a) memcpy(a, src, n * sizeof(T));
+}
+
+// Inclusive prefix sums: out[i] = a[0] + ... + a[i]. `out` may alias `a`.
+template <class T>
+void prefix_sum(const T *a, T *out, size_t n)
+{
+#ifdef CP_PAR_UNSEQ
+    if (n >= PAR_MIN) { std::inclusive_scan(std::execution::par_unseq, a, a + n, out); return; }
+#endif
+    T run = 0;
+    for (size_t i = 0; i < n; i++) out[i] = run += a[i];
+}
+inline void prefix_sum(const long long *a, long long *out, size_t n)
+{
+    size_t i = 0;
+    long long run = 0;
+#ifdef CP_PAR_UNSEQ
+    if (n >= PAR_MIN) { std::inclusive_scan(std::execution::par_unseq, a, a + n, out); return; }
+#endif
+#ifdef __AVX2__
+    // Scan each block of 4 in-register (shift by one lane, then by two), then add the carry
+    __m256i carry = _mm256_setzero_si256(), zero = _mm256_setzero_si256();
+    for (; i + 4 <= n; i += 4)
+    {
+        __m256i x = _mm256_loadu_si256((const __m256i *)(a + i));
+        x = _mm256_add_epi64(x, _mm256_blend_epi32(_mm256_permute4x64_epi64(x, 0x90), zero, 0x03));
+        x = _mm256_add_epi64(x, _mm256_permute2x128_si256(x, x, 0x08));
+        x = _mm256_add_epi64(x, carry);
+        _mm256_storeu_si256((__m256i *)(out + i), x);
+        carry = _mm256_permute4x64_epi64(x, 0xff);
+    }
+    if (i) run = out[i - 1];
+#endif
+    for (; i < n; i++) out[i] = run += a[i];
+}
+inline void prefix_sum(const int *a, int *out, size_t n)
+{
+    size_t i = 0;
+    int run = 0;
+#ifdef CP_PAR_UNSEQ
+    if (n >= PAR_MIN) { std::inclusive_scan(std::execution::par_unseq, a, a + n, out); return; }
+#endif
+#ifdef __AVX2__
+    __m256i carry = _mm256_setzero_si256(), last = _mm256_set1_epi32(7);
+    for (; i + 8 <= n; i += 8)
+    {
+        __m256i x = _mm256_loadu_si256((const __m256i *)(a + i));
+        x = _mm256_add_epi32(x, _mm256_slli_si256(x, 4)); // Scans within each 128-bit half
+        x = _mm256_add_epi32(x, _mm256_slli_si256(x, 8));
+        __m256i low_total = _mm256_shuffle_epi32(x, 0xff);
+        x = _mm256_add_epi32(x, _mm256_permute2x128_si256(low_total, low_total, 0x08));
+        x = _mm256_add_epi32(x, carry);
+        _mm256_storeu_si256((__m256i *)(out + i), x);
+        carry = _mm256_permutevar8x32_epi32(x, last);
+    }
+    if (i) run = out[i - 1];
+#endif
+    for (; i < n; i++) out[i] = run += a[i];
+}
+
+// Sum as long long, so int inputs cannot overflow the result
+template <class T>
+long long sum(const T *a, size_t n)
+{
+#ifdef CP_PAR_UNSEQ
+    if (n >= PAR_MIN) return std::transform_reduce(std::execution::par_unseq, a, a + n, 0LL, std::plus<long long>(), [](T x) { return (long long)x; });
+#endif
+    long long s = 0;
+    for (size_t i = 0; i < n; i++) s += a[i];
+    return s;
+}
+inline long long sum(const long long *a, size_t n)
+{
+#ifdef CP_PAR_UNSEQ
+    if (n >= PAR_MIN) return std::reduce(std::execution::par_unseq, a, a + n, 0LL);
+#endif
+    size_t i = 0;
+    long long s = 0;
+#ifdef __AVX2__
+    __m256i acc0 = _mm256_setzero_si256(), acc1 = _mm256_setzero_si256();
+    for (; i + 8 <= n; i += 8)
+    {
+        acc0 = _mm256_add_epi64(acc0, _mm256_loadu_si256((const __m256i *)(a + i)));
+        acc1 = _mm256_add_epi64(acc1, _mm256_loadu_si256((const __m256i *)(a + i + 4)));
+    }
+    long long lanes[4];
+    _mm256_storeu_si256((__m256i *)lanes, _mm256_add_epi64(acc0, acc1));
+    s = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#endif
+    for (; i < n; i++) s += a[i];
+    return s;
+}
+inline long long sum(const int *a, size_t n)
+{
+#ifdef CP_PAR_UNSEQ
+    if (n >= PAR_MIN) return std::transform_reduce(std::execution::par_unseq, a, a + n, 0LL, std::plus<long long>(), [](int x) { return (long long)x; });
+#endif
+    size_t i = 0;
+    long long s = 0;
+#ifdef __AVX2__
+    __m256i acc0 = _mm256_setzero_si256(), acc1 = _mm256_setzero_si256();
+    for (; i + 8 <= n; i += 8)
+    {
+        __m256i x = _mm256_loadu_si256((const __m256i *)(a + i));
+        acc0 = _mm256_add_epi64(acc0, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(x)));
+        acc1 = _mm256_add_epi64(acc1, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(x, 1)));
+    }
+    long long lanes[4];
+    _mm256_storeu_si256((__m256i *)lanes, _mm256_add_epi64(acc0, acc1));
+    s = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#endif
+    for (; i < n; i++) s += a[i];
+    return s;
+}
+
+// Smallest / largest element; n must be at least 1
+template <class T>
+T min_value(const T *a, size_t n)
+{
+#ifdef CP_PAR_UNSEQ
+    if (n >= PAR_MIN) return *std::min_element(std::execution::par_unseq, a, a + n);
+#endif
+    T m = a[0];
+    for (size_t i = 1; i < n; i++) m = a[i] < m ? a[i] : m;
+    return m;
+}
+template <class T>
+T max_value(const T *a, size_t n)
+{
+#ifdef CP_PAR_UNSEQ
+    if (n >= PAR_MIN) return *std::max_element(std::execution::par_unseq, a, a + n);
+#endif
+    T m = a[0];
+    for (size_t i = 1; i < n; i++) m = a[i] > m ? a[i] : m;
+    return m;
+}
+#ifdef __AVX2__
+// AVX2 has no 64-bit min/max, so compare and blend
+inline long long min_value(const long long *a, size_t n)
+{
+#ifdef CP_PAR_UNSEQ
+    if (n >= PAR_MIN) return *std::min_element(std::execution::par_unseq, a, a + n);
+#endif
+    if (n < 4) return min_value<long long>(a, n);
+    __m256i m = _mm256_loadu_si256((const __m256i *)a);
+    size_t i = 4;
+    for (; i + 4 <= n; i += 4)
+    {
+        __m256i x = _mm256_loadu_si256((const __m256i *)(a + i));
+        m = _mm256_blendv_epi8(m, x, _mm256_cmpgt_epi64(m, x));
+    }
+    long long lanes[4];
+    _mm256_storeu_si256((__m256i *)lanes, m);
+    long long r = std::min(std::min(lanes[0], lanes[1]), std::min(lanes[2], lanes[3]));
+    for (; i < n; i++) r = std::min(r, a[i]);
+    return r;
+}
+inline long long max_value(const long long *a, size_t n)
+{
+#ifdef CP_PAR_UNSEQ
+    if (n >= PAR_MIN) return *std::max_element(std::execution::par_unseq, a, a + n);
+#endif
+    if (n < 4) return max_value<long long>(a, n);
+    __m256i m = _mm256_loadu_si256((const __m256i *)a);
+    size_t i = 4;
+    for (; i + 4 <= n; i += 4)
+    {
+        __m256i x = _mm256_loadu_si256((const __m256i *)(a + i));
+        m = _mm256_blendv_epi8(m, x, _mm256_cmpgt_epi64(x, m));
+    }
+    long long lanes[4];
+    _mm256_storeu_si256((__m256i *)lanes, m);
+    long long r = std::max(std::max(lanes[0], lanes[1]), std::max(lanes[2], lanes[3]));
+    for (; i < n; i++) r = std::max(r, a[i]);
+    return r;
+}
+inline int min_value(const int *a, size_t n)
+{
+#ifdef CP_PAR_UNSEQ
+    if (n >= PAR_MIN) return *std::min_element(std::execution::par_unseq, a, a + n);
+#endif
+    if (n < 8) return min_value<int>(a, n);
+    __m256i m = _mm256_loadu_si256((const __m256i *)a);
+    size_t i = 8;
+    for (; i + 8 <= n; i += 8) m = _mm256_min_epi32(m, _mm256_loadu_si256((const __m256i *)(a + i)));
+    int lanes[8];
+    _mm256_storeu_si256((__m256i *)lanes, m);
+    int r = *std::min_element(lanes, lanes + 8);
+    for (; i < n; i++) r = std::min(r, a[i]);
+    return r;
+}
+inline int max_value(const int *a, size_t n)
+{
+#ifdef CP_PAR_UNSEQ
+    if (n >= PAR_MIN) return *std::max_element(std::execution::par_unseq, a, a + n);
+#endif
+    if (n < 8) return max_value<int>(a, n);
+    __m256i m = _mm256_loadu_si256((const __m256i *)a);
+    size_t i = 8;
+    for (; i + 8 <= n; i += 8) m = _mm256_max_epi32(m, _mm256_loadu_si256((const __m256i *)(a + i)));
+    int lanes[8];
+    _mm256_storeu_si256((__m256i *)lanes, m);
+    int r = *std::max_element(lanes, lanes + 8);
+    for (; i < n; i++) r = std::max(r, a[i]);
+    return r;
+}
+#endif
+
+// Container forms: anything with data() and size()
+template <class C>
+void radix_sort(C &c) { radix_sort(c.data(), c.size()); }
+template <class C>
+void prefix_sum(C &c) { prefix_sum(c.data(), c.data(), c.size()); }
+template <class C>
+long long sum(const C &c) { return sum(c.data(), c.size()); }
+template <class C>
+auto min_value(const C &c) -> decltype(min_value(c.data(), c.size())) { return min_value(c.data(), c.size()); }
+template <class C>
+auto max_value(const C &c) -> decltype(max_value(c.data(), c.size())) { return max_value(c.data(), c.size()); }
+
+} // namespace cp
@@ -0,0 +1,53 @@
+// Arena and arena_vector for the CP template (and the graph.hpp builders that use them).
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+// Bump allocator for per-test storage: reserve once, reset() at the top of each test case
+struct Arena
+{
+    std::unique_ptr<char[]> base;
+    size_t cap, used = 0;
+
+    explicit Arena(size_t bytes) : base(new char[bytes]), cap(bytes) {}
+    void reset() { used = 0; }
+    // Scratch space: `size_t m = A.mark(); ...; A.rollback(m);` frees everything allocated since
+    size_t mark() const { return used; }
+    void rollback(size_t m) { used = m; }
+
+    template <class T>
+    T *alloc(size_t n)
+    {
+        size_t start = (used + alignof(T) - 1) & ~(alignof(T) - 1);
+        if (start + n * sizeof(T) > cap) throw std::bad_alloc();
+        used = start + n * sizeof(T);
+        return reinterpret_cast<T *>(base.get() + start);
+    }
+};
+
+// Fixed-size, zero-initialised array carved out of an Arena (trivial types only)
+template <class T>
+struct arena_vector
+{
+    static_assert(std::is_trivially_copyable<T>::value, "arena_vector holds trivial types");
+    T *p;
+    size_t n;
+
+    arena_vector(Arena &A, size_t n) : p(A.alloc<T>(n)), n(n) { std::memset(p, 0, n * sizeof(T)); }
+    T &operator[](size_t i) { return p[i]; }
+    const T &operator[](size_t i) const { return p[i]; }
+    T *begin() { return p; }
+    T *end() { return p + n; }
+    const T *begin() const { return p; }
+    const T *end() const { return p + n; }
+    T *data() { return p; }
+    const T *data() const { return p; }
+    size_t size() const { return n; }
+    bool empty() const { return n == 0; }
+    T &front() { return p[0]; }
+    T &back() { return p[n - 1]; }
+};
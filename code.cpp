@@ -8,6 +8,26 @@
 #include <climits>
 #include <stack>
 #include <fstream>
+#include <cstdio>
+#include <chrono>
+#ifdef CP_PARALLEL
+#include <thread>
+#include <mutex>
+#include <deque>
+#endif
+
+#include "fastio.hpp" // FastReader, FastWriter, span
+#include "hashmap.hpp" // flat_map, flat_set: prefer over unordered_map/unordered_set
+#include "algo.hpp" // cp::radix_sort, prefix_sum, sum, min_value, max_value
+#include "arena.hpp" // Arena, arena_vector
+#include "graph.hpp" // cp::graph, read_graph, iterative bfs/dfs
+#ifdef _WIN32
+#ifdef CP_PROFILE
+#include <psapi.h>
+#endif
+#else
+#include <sys/resource.h>
+#endif
 using namespace std;
 
 #define vi vector<int>
@@ -18,6 +38,188 @@ using namespace std;
 #define rep(i, a, b) for (long long i = a; i < b; i++)
 #define f(a,n) for (long long i = a; i < n; i++)
 
+const size_t ARENA_BYTES = 1 << 26; // 64 MiB: sum of n up to ~8e6 long longs (CP_PARALLEL keeps every test)
+
+// Build with -DCP_PROFILE for a phase/per-test timing and peak RSS summary on stderr.
+// WRITE is the time the attached FastWriter spends handing bytes to stdout, whichever
+// phase it happens in; formatting output inside solve() stays part of SOLVE.
+#ifdef CP_PROFILE
+struct Profiler
+{
+    typedef chrono::steady_clock clk;
+    enum Phase { READ, SOLVE, WRITE, NPHASE };
+    double total[NPHASE] = {};
+    int cur = -1;
+    clk::time_point mark, test_start, start = clk::now();
+    vector<double> tests;
+    const FastWriter *writer = nullptr;
+    double emitted = 0; // writer->emit_ms already billed to WRITE
+
+    static double ms(clk::duration d) { return chrono::duration<double, milli>(d).count(); }
+    void phase(int p)
+    {
+        clk::time_point now = clk::now();
+        double io = writer ? writer->emit_ms - emitted : 0;
+        if (writer) emitted = writer->emit_ms;
+        if (cur >= 0)
+        {
+            total[cur] += ms(now - mark) - io;
+            total[WRITE] += io;
+        }
+        cur = p;
+        mark = now;
+    }
+    void test_begin() { test_start = clk::now(); }
+    void test_end() { tests.push_back(ms(clk::now() - test_start)); }
+
+    static double peak_rss_mb()
+    {
+#ifdef _WIN32
+        PROCESS_MEMORY_COUNTERS pmc;
+        if (!GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc))) return 0;
+        return pmc.PeakWorkingSetSize / 1048576.0;
+#else
+        struct rusage ru;
+        getrusage(RUSAGE_SELF, &ru);
+#ifdef __APPLE__
+        return ru.ru_maxrss / 1048576.0;
+#else
+        return ru.ru_maxrss / 1024.0;
+#endif
+#endif
+    }
+    void report()
+    {
+        phase(-1);
+        fprintf(stderr, "[profile] wall %.3f ms | read %.3f | solve + format %.3f | write (flush) %.3f\n",
+                ms(clk::now() - start), total[READ], total[SOLVE], total[WRITE]);
+        if (!tests.empty())
+        {
+            size_t worst = max_element(tests.begin(), tests.end()) - tests.begin();
+            double sum = 0;
+            for (double x : tests) sum += x;
+            vector<double> sorted = tests;
+            sort(sorted.begin(), sorted.end());
+            fprintf(stderr, "[profile] tests %zu | avg %.4f ms | p50 %.4f | p99 %.4f | max %.4f (#%zu)\n",
+                    tests.size(), sum / tests.size(), sorted[sorted.size() / 2],
+                    sorted[min(sorted.size() - 1, sorted.size() * 99 / 100)], tests[worst], worst + 1);
+        }
+        fprintf(stderr, "[profile] peak rss %.2f MiB\n", peak_rss_mb());
+    }
+};
+Profiler prof;
+#define PROF_WRITER(w) (prof.writer = &(w))
+#define PROF_PHASE(p) prof.phase(Profiler::p)
+#define PROF_TEST_BEGIN() prof.test_begin()
+#define PROF_TEST_END() prof.test_end()
+#define PROF_REPORT() prof.report()
+#else
+#define PROF_WRITER(w) ((void)0)
+#define PROF_PHASE(p) ((void)0)
+#define PROF_TEST_BEGIN() ((void)0)
+#define PROF_TEST_END() ((void)0)
+#define PROF_REPORT() ((void)0)
+#endif
+
+ //your code starts here (remove the rest as you like)
+struct TestCase
+{
+    long long n;
+    arena_vector<long long> a;
+};
+
+TestCase read_test(FastReader &in, Arena &arena)
+{
+    long long n;
+    in >> n;
+    arena_vector<long long> a(arena, n);
+    in.read_vector(a.data(), n);
+    return {n, a};
+}
+
+void solve(const TestCase &tc, FastWriter &out)
+{
+    f(0,tc.n){out << tc.a[i] << ' ';}
+    out.newline();
+}
+
+// CP_STREAM: the same solution over a[] as it is parsed, for n too large to hold
+void solve_stream(long long n, TokenStream<long long> &a, FastWriter &out)
+{
+    (void)n;
+    for (long long x : a) out << x << ' ';
+    out.newline();
+}
+ //your code ends here
+
+// Build with -DCP_STREAM to hand each test's a[] to solve_stream() as a TokenStream instead
+// of materialising it: peak memory is the read buffer plus one chunk, independent of n
+#if defined(CP_STREAM) && defined(CP_PARALLEL)
+#error "CP_STREAM and CP_PARALLEL are mutually exclusive"
+#endif
+
+// Build with -DCP_PARALLEL (and -pthread) to parse every test up front, solve them on
+// all cores and write the results back in input order
+#ifdef CP_PARALLEL
+void run_parallel(const vector<TestCase> &tests, FastWriter &out)
+{
+    size_t T = tests.size();
+    unsigned W = max(1u, thread::hardware_concurrency());
+    vector<string> results(T);
+
+    // Each worker owns a contiguous run of tests; idle workers steal from the back of others
+    struct Queue
+    {
+        mutex m;
+        deque<size_t> q;
+    };
+    vector<Queue> queues(W);
+    for (size_t i = 0; i < T; i++) queues[i * W / T].q.push_back(i);
+
+    auto take = [&](unsigned self, size_t &idx)
+    {
+        {
+            lock_guard<mutex> g(queues[self].m);
+            if (!queues[self].q.empty())
+            {
+                idx = queues[self].q.front();
+                queues[self].q.pop_front();
+                return true;
+            }
+        }
+        for (unsigned k = 1; k < W; k++)
+        {
+            Queue &victim = queues[(self + k) % W];
+            lock_guard<mutex> g(victim.m);
+            if (!victim.q.empty())
+            {
+                idx = victim.q.back();
+                victim.q.pop_back();
+                return true;
+            }
+        }
+        return false;
+    };
+
+    vector<thread> pool;
+    for (unsigned w = 0; w < W; w++)
+        pool.emplace_back([&, w]
+        {
+            FastWriter local;
+            size_t idx;
+            while (take(w, idx))
+            {
+                local.sink = &results[idx];
+                solve(tests[idx], local);
+                local.flush();
+            }
+        });
+    for (thread &th : pool) th.join();
+
+    for (const string &r : results) out << r;
+}
+#endif
+
 int main()
 {
     // Redirect input and output
@@ -26,18 +228,49 @@ int main()
 
     ios_base::sync_with_stdio(false);
     cin.tie(nullptr);
- //your code starts here (remove the rest as you like)
+    FastReader in; // swap `cin >>` for `in >>` on big inputs
+#ifndef CP_STREAM
+    in.map_stdin(); // falls back to buffered reads when stdin is a pipe
+#endif // (mapped pages count towards RSS, so streaming sticks to the buffer)
+    FastWriter out; // swap `cout <<` for `out <<`, `endl` for out.newline()
+    Arena arena(ARENA_BYTES);
+    PROF_WRITER(out);
+    PROF_PHASE(READ);
     long long t;
-    cin >> t;
+    in >> t;
+#ifdef CP_PARALLEL
+    vector<TestCase> tests;
+    tests.reserve(t);
+    f(0,t){tests.push_back(read_test(in, arena));}
+    PROF_PHASE(SOLVE);
+    run_parallel(tests, out);
+#elif defined(CP_STREAM)
     while (t--)
     {
+        PROF_TEST_BEGIN();
+        PROF_PHASE(SOLVE); // Parsing happens inside solve_stream()
         long long n;
-        cin >> n;
-        vector<long long> a(n);
-        f(0,n){cin >> a[i];}
-        f(0,n){cout << a[i] << " ";}
-        cout << endl;
+        in >> n;
+        TokenStream<long long> a(in, n);
+        solve_stream(n, a, out);
+        a.skip_rest();
+        PROF_TEST_END();
+    }
+#else
+    while (t--)
+    {
+        PROF_TEST_BEGIN();
+        PROF_PHASE(READ);
+        arena.reset();
+        TestCase tc = read_test(in, arena);
+        PROF_PHASE(SOLVE);
+        solve(tc, out);
+        PROF_TEST_END();
     }
+#endif
 
+    PROF_PHASE(WRITE);
+    out.flush();
+    PROF_REPORT();
     return 0;
 }
@@ -1,77 +1,1113 @@
 #include <iostream>
 #include <vector>
-#include <random>
 #include <chrono>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <algorithm>
+#include <type_traits>
+#include <stdexcept>
+#include <csignal>
 #include <cstdlib>
+#include <string>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
 #include <fcntl.h>
 
+#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64)
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 #ifdef _WIN32
 #include <windows.h>
 #include <conio.h>
 #else
 #include <termios.h>
 #include <unistd.h>
+#include <poll.h>
 #include <sys/ioctl.h>
 #endif
 
-class Matrix {
+// Row-major width*height grid in one contiguous allocation
+template <typename T>
+class Grid {
+private:
+    int w = 0, h = 0;
+    std::vector<T> cells;
+
+public:
+    void assign(int width, int height, T value) {
+        w = width;
+        h = height;
+        cells.assign(static_cast<size_t>(width) * height, value);
+    }
+    
+    // Changes the dimensions in place, keeping the overlapping top-left region; the
+    // allocation is reused whenever its capacity already covers the new size
+    void reshape(int width, int height, T value) {
+        if (width == w && height == h) return;
+        size_t old_w = w, new_w = width;
+        size_t rows = std::min(h, height), cols = std::min(w, width);
+        if (new_w <= old_w) {
+            for (size_t r = 1; r < rows; ++r) {
+                std::copy(cells.begin() + r * old_w, cells.begin() + r * old_w + cols, cells.begin() + r * new_w);
+            }
+            cells.resize(new_w * height, value);
+        } else {
+            cells.resize(std::max(cells.size(), new_w * height), value);
+            for (size_t r = rows; r-- > 0;) {
+                std::copy_backward(cells.begin() + r * old_w, cells.begin() + r * old_w + cols,
+                                   cells.begin() + r * new_w + cols);
+                std::fill(cells.begin() + r * new_w + cols, cells.begin() + (r + 1) * new_w, value);
+            }
+            cells.resize(new_w * height);
+        }
+        std::fill(cells.begin() + rows * new_w, cells.end(), value);
+        w = width;
+        h = height;
+    }
+    
+    T& operator()(int row, int col) { return cells[static_cast<size_t>(row) * w + col]; }
+    const T& operator()(int row, int col) const { return cells[static_cast<size_t>(row) * w + col]; }
+    T* row(int r) { return cells.data() + static_cast<size_t>(r) * w; }
+    const T* row(int r) const { return cells.data() + static_cast<size_t>(r) * w; }
+    T* data() { return cells.data(); }
+    size_t size() const { return cells.size(); }
+};
+
+// Saturating fade of n cells: brightness drops by step and cells that reach 0 go blank
+// (glyph index 0). Branch-free so it vectorizes; relies on brightness 0 always pairing
+// with a blank glyph.
+inline void fadeCells(uint8_t* brightness, uint8_t* glyphs, size_t n, uint8_t step) {
+    size_t i = 0;
+#if defined(__AVX2__)
+    const __m256i vstep = _mm256_set1_epi8(static_cast<char>(step));
+    const __m256i zero = _mm256_setzero_si256();
+    for (; i + 32 <= n; i += 32) {
+        __m256i b = _mm256_subs_epu8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(brightness + i)), vstep);
+        __m256i dead = _mm256_cmpeq_epi8(b, zero);
+        __m256i g = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(glyphs + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(brightness + i), b);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(glyphs + i), _mm256_andnot_si256(dead, g));
+    }
+#elif defined(__SSE2__) || defined(_M_X64)
+    const __m128i vstep = _mm_set1_epi8(static_cast<char>(step));
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 16 <= n; i += 16) {
+        __m128i b = _mm_subs_epu8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(brightness + i)), vstep);
+        __m128i dead = _mm_cmpeq_epi8(b, zero);
+        __m128i g = _mm_loadu_si128(reinterpret_cast<const __m128i*>(glyphs + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(brightness + i), b);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(glyphs + i), _mm_andnot_si128(dead, g));
+    }
+#elif defined(__ARM_NEON)
+    const uint8x16_t vstep = vdupq_n_u8(step);
+    for (; i + 16 <= n; i += 16) {
+        uint8x16_t b = vqsubq_u8(vld1q_u8(brightness + i), vstep);
+        uint8x16_t dead = vceqq_u8(b, vdupq_n_u8(0));
+        uint8x16_t g = vld1q_u8(glyphs + i);
+        vst1q_u8(brightness + i, b);
+        vst1q_u8(glyphs + i, vbicq_u8(g, dead));
+    }
+#endif
+    for (; i < n; ++i) {
+        uint8_t b = brightness[i] > step ? brightness[i] - step : 0;
+        brightness[i] = b;
+        if (b == 0) glyphs[i] = 0;
+    }
+}
+
+// Lit cells in brightness[0..n); a plain reduction the compiler vectorizes
+inline size_t countLit(const uint8_t* brightness, size_t n) {
+    size_t lit = 0;
+    for (size_t i = 0; i < n; ++i) lit += brightness[i] != 0;
+    return lit;
+}
+
+// A pre-encoded UTF-8 glyph, ready to be copied straight into a frame
+struct Glyph {
+    char bytes[4];
+    uint8_t length;
+    uint32_t codepoint; // For the native Windows console backend, which takes UTF-16
+};
+
+// Splits a UTF-8 string into one Glyph per code point (re-encoded, so malformed input is
+// dropped rather than passed to the terminal). Entry 0 is the blank cell; grids store
+// indices as uint8_t, so the table holds at most 256 entries.
+inline std::vector<Glyph> buildGlyphTable(const std::string& utf8) {
+    std::vector<Glyph> table(1, Glyph{{' '}, 1, ' '});
+    for (size_t i = 0; i < utf8.size();) {
+        unsigned char lead = static_cast<unsigned char>(utf8[i]);
+        int extra = lead < 0x80 ? 0 : lead >= 0xf0 ? 3 : lead >= 0xe0 ? 2 : lead >= 0xc0 ? 1 : -1;
+        if (extra < 0 || i + extra >= utf8.size()) {
+            ++i;
+            continue;
+        }
+        uint32_t cp = extra == 0 ? lead : lead & (0x3f >> extra);
+        bool valid = true;
+        for (int k = 1; k <= extra; ++k) {
+            unsigned char next = static_cast<unsigned char>(utf8[i + k]);
+            valid = valid && (next & 0xc0) == 0x80;
+            cp = (cp << 6) | (next & 0x3f);
+        }
+        i += extra + 1;
+        if (!valid || cp < 0x21 || cp > 0x10ffff) continue;
+        
+        Glyph g = {{0}, 0, cp};
+        if (cp < 0x80) {
+            g.bytes[g.length++] = static_cast<char>(cp);
+        } else if (cp < 0x800) {
+            g.bytes[g.length++] = static_cast<char>(0xc0 | (cp >> 6));
+            g.bytes[g.length++] = static_cast<char>(0x80 | (cp & 0x3f));
+        } else if (cp < 0x10000) {
+            g.bytes[g.length++] = static_cast<char>(0xe0 | (cp >> 12));
+            g.bytes[g.length++] = static_cast<char>(0x80 | ((cp >> 6) & 0x3f));
+            g.bytes[g.length++] = static_cast<char>(0x80 | (cp & 0x3f));
+        } else {
+            g.bytes[g.length++] = static_cast<char>(0xf0 | (cp >> 18));
+            g.bytes[g.length++] = static_cast<char>(0x80 | ((cp >> 12) & 0x3f));
+            g.bytes[g.length++] = static_cast<char>(0x80 | ((cp >> 6) & 0x3f));
+            g.bytes[g.length++] = static_cast<char>(0x80 | (cp & 0x3f));
+        }
+        table.push_back(g);
+        if (table.size() == 256) break;
+    }
+    return table;
+}
+
+// 64x64 -> 128-bit multiply, returning the high half and storing the low half
+inline uint64_t mulHiLo(uint64_t a, uint64_t b, uint64_t* lo) {
+#if defined(__SIZEOF_INT128__)
+    unsigned __int128 m = static_cast<unsigned __int128>(a) * b;
+    *lo = static_cast<uint64_t>(m);
+    return static_cast<uint64_t>(m >> 64);
+#else
+    uint64_t a_lo = a & 0xffffffffu, a_hi = a >> 32, b_lo = b & 0xffffffffu, b_hi = b >> 32;
+    uint64_t ll = a_lo * b_lo, lh = a_lo * b_hi, hl = a_hi * b_lo, hh = a_hi * b_hi;
+    uint64_t mid = (ll >> 32) + (lh & 0xffffffffu) + (hl & 0xffffffffu);
+    *lo = (mid << 32) | (ll & 0xffffffffu);
+    return hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+#endif
+}
+
+inline uint64_t splitmix64(uint64_t& state) {
+    uint64_t z = (state += 0x9e3779b97f4a7c15ull);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+}
+
+// Small-state generators for the hot loop. Both are UniformRandomBitGenerators, so either
+// can back MatrixRng (or a std:: distribution); wyrand is the faster of the two.
+class WyRand {
+private:
+    uint64_t state;
+
+public:
+    using result_type = uint64_t;
+    explicit WyRand(uint64_t seed = 0) : state(seed) {}
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return ~0ull; }
+    
+    result_type operator()() {
+        state += 0xa0761d6478bd642full;
+        uint64_t lo, hi = mulHiLo(state, state ^ 0xe7037ed1a0b428dbull, &lo);
+        return hi ^ lo;
+    }
+};
+
+class Xoshiro256ss {
+private:
+    uint64_t s[4];
+    
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+public:
+    using result_type = uint64_t;
+    explicit Xoshiro256ss(uint64_t seed = 0) {
+        for (uint64_t& word : s) word = splitmix64(seed);
+    }
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return ~0ull; }
+    
+    result_type operator()() {
+        uint64_t result = rotl(s[1] * 5, 7) * 9, t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+        return result;
+    }
+};
+
+using MatrixRng = WyRand;
+
+// Uniform integer in [lo, hi] by multiply-shift of a 32-bit draw: no division and no
+// rejection loop; the bias (span / 2^32) is far below anything visible on screen
+class FastRange {
+private:
+    int lo = 0;
+    uint32_t span = 1;
+    
+    static int scale(uint32_t bits, int lo, uint32_t span) {
+        return lo + static_cast<int>((static_cast<uint64_t>(bits) * span) >> 32);
+    }
+
+public:
+    FastRange() = default;
+    FastRange(int low, int high) : lo(low), span(static_cast<uint32_t>(high - low + 1)) {}
+    
+    template <typename Rng>
+    int operator()(Rng& rng) const { return scale(static_cast<uint32_t>(rng() >> 32), lo, span); }
+    
+    // Fills out[0..n) with independent draws, two per 64-bit generator output
+    template <typename Rng>
+    void fill(Rng& rng, int* out, int n) const {
+        int i = 0;
+        for (; i + 2 <= n; i += 2) {
+            uint64_t bits = rng();
+            out[i] = scale(static_cast<uint32_t>(bits >> 32), lo, span);
+            out[i + 1] = scale(static_cast<uint32_t>(bits), lo, span);
+        }
+        if (i < n) out[i] = (*this)(rng);
+    }
+};
+
+// Persistent helper threads for data-parallel loops; the calling thread also takes work
+class WorkerPool {
+private:
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake, done;
+    std::function<void(int)> job;
+    int task_count = 0;
+    std::atomic<int> next_task{0};
+    int busy = 0;
+    unsigned long long generation = 0;
+    bool stopping = false;
+    
+    void drain() {
+        for (int task; (task = next_task.fetch_add(1)) < task_count;) job(task);
+    }
+    
+    void workerLoop() {
+        unsigned long long seen = 0;
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;) {
+            wake.wait(lock, [&] { return stopping || generation != seen; });
+            if (stopping) return;
+            seen = generation;
+            lock.unlock();
+            drain();
+            lock.lock();
+            if (--busy == 0) done.notify_one();
+        }
+    }
+
+public:
+    explicit WorkerPool(int threads) {
+        for (int i = 1; i < threads; ++i) workers.emplace_back([this] { workerLoop(); });
+    }
+    
+    ~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (std::thread& worker : workers) worker.join();
+    }
+    
+    int size() const { return static_cast<int>(workers.size()) + 1; }
+    
+    // Runs fn(0) .. fn(tasks - 1) across the pool and returns once all have finished
+    void run(int tasks, const std::function<void(int)>& fn) {
+        if (workers.empty() || tasks <= 1) {
+            for (int i = 0; i < tasks; ++i) fn(i);
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            job = fn;
+            task_count = tasks;
+            next_task = 0;
+            busy = static_cast<int>(workers.size());
+            ++generation;
+        }
+        wake.notify_all();
+        drain();
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [&] { return busy == 0; });
+    }
+};
+
+// One independently composed slice of a frame (a row band, or a column tile in sparse mode)
+struct PaintedCell {
+    uint32_t index; // row * width + col
+    uint8_t glyph, klass;
+};
+
+struct FrameBand {
+    std::string out;
+    int level = -1; // SGR color in effect after `out` (-1 = unknown)
+    int cursor_row = -1, cursor_col = -1;
+    size_t scanned = 0, painted = 0; // Cells examined / emitted while composing `out`
+    size_t escapes = 0; // Cursor moves and color changes in `out`
+    std::vector<PaintedCell> painted_cells; // What `out` repaints, kept only while recording
+    
+    void reset(int start_level) {
+        out.clear();
+        painted_cells.clear();
+        level = start_level;
+        cursor_row = cursor_col = -1;
+        scanned = painted = escapes = 0;
+    }
+};
+
+// Hot-path counters over one or more frames. They are bumped once per column, band or
+// write, never per cell, so they stay on all the time; only `faded` needs its own pass
+// over the grid and is counted only while someone is looking (see Matrix::count_faded).
+// Aligned so per-tile copies never share a cache line.
+struct alignas(64) FrameStats {
+    uint64_t faded = 0;       // Lit cells dimmed by the fade pass (dense mode)
+    uint64_t painted = 0;     // Cells re-emitted by render()
+    uint64_t drops_reset = 0; // Drops that ran off the screen and respawned
+    uint64_t rng_draws = 0;   // Generator outputs consumed by update()
+    uint64_t escapes = 0;     // Cursor moves and color changes emitted
+    uint64_t bytes = 0;       // Frame bytes handed to the terminal
+    uint64_t writes = 0;      // write() / WriteConsole calls
+    uint64_t frames = 0;
+    std::chrono::steady_clock::duration update_time{}, render_time{};
+    
+    void add(const FrameStats& o) {
+        faded += o.faded;
+        painted += o.painted;
+        drops_reset += o.drops_reset;
+        rng_draws += o.rng_draws;
+        escapes += o.escapes;
+        bytes += o.bytes;
+        writes += o.writes;
+        frames += o.frames;
+        update_time += o.update_time;
+        render_time += o.render_time;
+    }
+};
+
+// Set when the terminal size changes (SIGWINCH, or the input thread on _WIN32); the
+// frame loop picks it up and calls Matrix::resize()
+static std::atomic<bool> resize_pending{false};
+static_assert(ATOMIC_BOOL_LOCK_FREE == 2, "resize_pending is set from a signal handler");
+
+#ifndef _WIN32
+static void onResizeSignal(int) {
+    resize_pending = true;
+}
+
+// Terminal state saved by Matrix::enterRawMode(); file-scope so signal handlers can restore it
+static struct termios saved_termios;
+static volatile sig_atomic_t raw_mode_active = 0;
+static volatile sig_atomic_t saved_stdout_flags = -1; // Set while OutputQueue holds stdout non-blocking
+
+static void restoreStdoutFlags() {
+    if (saved_stdout_flags >= 0) {
+        fcntl(STDOUT_FILENO, F_SETFL, saved_stdout_flags);
+        saved_stdout_flags = -1;
+    }
+}
+
+static void restoreTerminal() {
+    if (raw_mode_active) {
+        tcsetattr(STDIN_FILENO, TCSANOW, &saved_termios);
+        raw_mode_active = 0;
+    }
+    restoreStdoutFlags();
+}
+
+static void onFatalSignal(int sig) {
+    restoreTerminal();
+    const char reset[] = "\033[0m\033[?25h";
+    ssize_t ignored = write(STDOUT_FILENO, reset, sizeof(reset) - 1);
+    (void)ignored;
+    signal(sig, SIG_DFL);
+    raise(sig);
+}
+#endif
+
+inline char* writeInt(char* p, int value) {
+    char digits[12];
+    int n = 0;
+    do {
+        digits[n++] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    } while (value > 0);
+    while (n > 0) *p++ = digits[--n];
+    return p;
+}
+
+inline void appendCursorMove(std::string& out, int row, int col) {
+    char buf[32] = "\033[";
+    char* p = writeInt(buf + 2, row + 1);
+    *p++ = ';';
+    p = writeInt(p, col + 1);
+    *p++ = 'H';
+    out.append(buf, p - buf);
+}
+
+// Returns the number of write calls it took
+inline int writeStdout(const char* data, size_t size) {
+#ifdef _WIN32
+    HANDLE out = GetStdHandle(STD_OUTPUT_HANDLE);
+    DWORD written = 0;
+    if (!WriteConsoleA(out, data, static_cast<DWORD>(size), &written, nullptr)) {
+        WriteFile(out, data, static_cast<DWORD>(size), &written, nullptr);
+        return 2;
+    }
+    return 1;
+#else
+    int calls = 0;
+    while (size > 0) {
+        ssize_t n = write(STDOUT_FILENO, data, size);
+        ++calls;
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                struct pollfd pfd = {STDOUT_FILENO, POLLOUT, 0};
+                poll(&pfd, 1, -1);
+                continue;
+            }
+            return calls;
+        }
+        data += n;
+        size -= n;
+    }
+    return calls;
+#endif
+}
+
+// Frame output for the interactive loop. While enabled, stdout is non-blocking and a frame
+// the terminal cannot take at once stays queued here instead of stalling the loop; the
+// caller skips frames until busy() clears, so a slow link costs frames, not latency.
+// Without non-blocking output (_WIN32, or fcntl fails) push() simply writes through.
+class OutputQueue {
+private:
+    std::string pending;
+    size_t offset = 0;
+    bool nonblocking = false;
+
+public:
+    uint64_t writes = 0; // Write calls so far, including ones that hit EAGAIN
+    
+    void enable() {
+#ifndef _WIN32
+        int flags = fcntl(STDOUT_FILENO, F_GETFL);
+        if (nonblocking || flags < 0) return;
+        saved_stdout_flags = flags; // Before switching, so an early signal still restores it
+        if (fcntl(STDOUT_FILENO, F_SETFL, flags | O_NONBLOCK) == 0) {
+            nonblocking = true;
+        } else {
+            saved_stdout_flags = -1;
+        }
+#endif
+    }
+    
+    // Back to blocking output, writing out whatever is still queued
+    void disable() {
+        if (!nonblocking) return;
+#ifndef _WIN32
+        restoreStdoutFlags();
+#endif
+        nonblocking = false;
+        writes += writeStdout(pending.data() + offset, pending.size() - offset);
+        pending.clear();
+        offset = 0;
+    }
+    
+    bool busy() const { return offset < pending.size(); }
+    
+    // Bytes written but not yet sent on by the terminal driver (0 where unknown)
+    size_t kernelQueued() const {
+#if !defined(_WIN32) && defined(TIOCOUTQ)
+        int queued = 0;
+        if (ioctl(STDOUT_FILENO, TIOCOUTQ, &queued) == 0 && queued > 0) return static_cast<size_t>(queued);
+#endif
+        return 0;
+    }
+    
+    void push(const char* data, size_t size) {
+        if (!nonblocking) {
+            writes += writeStdout(data, size);
+            return;
+        }
+        if (!busy()) {
+            pending.clear();
+            offset = 0;
+        }
+        pending.append(data, size);
+        flush();
+    }
+    
+    // Writes as much as the terminal accepts without blocking; true once nothing is queued
+    bool flush() {
+#ifndef _WIN32
+        while (busy()) {
+            ssize_t n = write(STDOUT_FILENO, pending.data() + offset, pending.size() - offset);
+            ++writes;
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                if (errno == EAGAIN || errno == EWOULDBLOCK) return false;
+                offset = pending.size(); // Output is gone; nothing left to wait for
+                break;
+            }
+            offset += static_cast<size_t>(n);
+        }
+#endif
+        return true;
+    }
+};
+
+#ifdef _WIN32
+// Lets the console interpret the same escape sequences the POSIX path emits
+inline bool enableConsoleVT() {
+    HANDLE out = GetStdHandle(STD_OUTPUT_HANDLE);
+    DWORD mode = 0;
+    bool ok = GetConsoleMode(out, &mode) && SetConsoleMode(out, mode | ENABLE_VIRTUAL_TERMINAL_PROCESSING);
+    SetConsoleOutputCP(CP_UTF8); // Glyphs are written as pre-encoded UTF-8
+    return ok;
+}
+#endif
+
+enum class ColorDepth { Auto, Basic16, Indexed256, TrueColor };
+
+inline ColorDepth detectColorDepth() {
+    const char* colorterm = std::getenv("COLORTERM");
+    if (colorterm && (std::strstr(colorterm, "truecolor") || std::strstr(colorterm, "24bit"))) {
+        return ColorDepth::TrueColor;
+    }
+#ifdef _WIN32
+    if (std::getenv("WT_SESSION")) return ColorDepth::TrueColor; // Windows Terminal
+#endif
+    const char* term = std::getenv("TERM");
+    if (term && std::strstr(term, "256color")) return ColorDepth::Indexed256;
+    return ColorDepth::Basic16;
+}
+
+// Brightness level -> SGR escape, formatted once at startup. Levels whose escapes are
+// identical share a color class, so the renderer never switches between equal colors.
+class Palette {
+private:
+    struct Code {
+        char bytes[24];
+        uint8_t length;
+    };
+    std::vector<Code> codes; // Indexed by color class; class 0 is "unlit"
+    std::vector<uint8_t> class_of; // Brightness 0 (unlit) .. max_level (drop head)
+
+public:
+    explicit Palette(ColorDepth depth = ColorDepth::Basic16, int max_level = 10) {
+        if (depth == ColorDepth::Auto) depth = detectColorDepth();
+        max_level = std::max(1, max_level);
+        codes.assign(1, Code{{0}, 0});
+        class_of.assign(max_level + 1, 0);
+        for (int level = 1; level <= max_level; ++level) {
+            Code code = {{0}, 0};
+            int n;
+            bool head = level == max_level && max_level > 1;
+            int step = max_level > 2 ? (level - 1) * 1000 / (max_level - 2) : 1000; // 0..1000 below the head
+            if (depth == ColorDepth::TrueColor) {
+                // Dark to bright green, with a pale head
+                int green = 60 + (255 - 60) * std::min(step, 1000) / 1000;
+                n = head ? std::snprintf(code.bytes, sizeof(code.bytes), "\033[38;2;190;255;190m")
+                         : std::snprintf(code.bytes, sizeof(code.bytes), "\033[38;2;0;%d;0m", green);
+            } else if (depth == ColorDepth::Indexed256) {
+                static const int cube_greens[] = {22, 28, 34, 40, 46};
+                int index = head ? 157 : cube_greens[std::min(step, 1000) * 4 / 1000];
+                n = std::snprintf(code.bytes, sizeof(code.bytes), "\033[38;5;%dm", index);
+            } else {
+                n = std::snprintf(code.bytes, sizeof(code.bytes), level > max_level / 2 ? "\033[92m" : "\033[32m"); // Bright / dim green
+            }
+            code.length = static_cast<uint8_t>(n);
+            
+            size_t klass = 1;
+            while (klass < codes.size() && std::strcmp(codes[klass].bytes, code.bytes) != 0) ++klass;
+            if (klass == codes.size()) codes.push_back(code);
+            class_of[level] = static_cast<uint8_t>(klass);
+        }
+    }
+    
+    uint8_t colorClass(int level) const {
+        int top = static_cast<int>(class_of.size()) - 1;
+        return class_of[level <= 0 ? 0 : level >= top ? top : level];
+    }
+    
+    void append(std::string& out, uint8_t klass) const { out.append(codes[klass].bytes, codes[klass].length); }
+    size_t classCount() const { return codes.size(); }
+};
+
+// Tuning constants for the rain. A config with static constexpr members lets the compiler
+// fold them and unroll the per-drop tail loop; RuntimeMatrixConfig has the same fields as
+// ordinary members so they can come from the command line. Both are used as `cfg.field`.
+struct DefaultMatrixConfig {
+    static constexpr int min_speed = 1, max_speed = 4;   // Ticks per row; faster speeds
+    static constexpr int min_trail = 7, max_trail = 10;  // Trail length; shorter trails
+    static constexpr int max_spawn = 50;                 // Extra rows above screen on respawn
+    static constexpr int fade_step = 3;                  // Brightness lost per tick; faster fading
+    static constexpr int max_brightness = 10;            // Drop head
+};
+
+struct RuntimeMatrixConfig {
+    int min_speed = DefaultMatrixConfig::min_speed, max_speed = DefaultMatrixConfig::max_speed;
+    int min_trail = DefaultMatrixConfig::min_trail, max_trail = DefaultMatrixConfig::max_trail;
+    int max_spawn = DefaultMatrixConfig::max_spawn;
+    int fade_step = DefaultMatrixConfig::fade_step;
+    int max_brightness = DefaultMatrixConfig::max_brightness;
+};
+
+// Frame trace format (all integers LEB128 varints unless noted):
+//   header  "MXRC" u8:version  glyph_count  { u8:length bytes }*
+//   'P'     class_count { u8:length bytes }*    SGR escape per color class (class 0 unused)
+//   'S'     width height                        grid (re)sized; the next frame is complete
+//   'F'     micros_since_last run_count { skip length { u8:glyph u8:class }* }*
+// A frame holds exactly the cells the renderer repainted, in the palette's color classes;
+// 'P' comes first and again whenever the palette changes. Cell positions are row-major;
+// `skip` counts unchanged cells since the previous run.
+class FrameRecorder {
+private:
+    FILE* file = nullptr;
+    std::string body, record;
+    size_t header_size = 0; // Offset of the run count in `record`
+    size_t runs = 0, run_end = 0, gap_start = 0, run_start = 0;
+    bool in_run = false, started = false;
+    int width = 0, height = 0;
+    std::chrono::steady_clock::time_point last_time;
+    
+    static void putVarint(std::string& out, uint64_t value) {
+        while (value >= 0x80) {
+            out += static_cast<char>((value & 0x7f) | 0x80);
+            value >>= 7;
+        }
+        out += static_cast<char>(value);
+    }
+    
+    void closeRun() {
+        if (!in_run) return;
+        putVarint(record, run_start - gap_start);
+        putVarint(record, run_end - run_start);
+        record += body;
+        body.clear();
+        gap_start = run_end;
+        ++runs;
+        in_run = false;
+    }
+
+public:
+    FrameRecorder(const std::string& path, const std::vector<Glyph>& glyphs) {
+        file = std::fopen(path.c_str(), "wb");
+        if (!file) throw std::runtime_error("cannot open " + path + " for recording");
+        std::string header = "MXRC";
+        header += static_cast<char>(2);
+        putVarint(header, glyphs.size());
+        for (const Glyph& g : glyphs) {
+            header += static_cast<char>(g.length);
+            header.append(g.bytes, g.length);
+        }
+        std::fwrite(header.data(), 1, header.size(), file);
+    }
+    
+    ~FrameRecorder() {
+        if (file) std::fclose(file);
+    }
+    
+    // Between frames only
+    void setPalette(const Palette& palette) {
+        std::string entry, out = "P";
+        putVarint(out, palette.classCount());
+        for (size_t klass = 0; klass < palette.classCount(); ++klass) {
+            entry.clear();
+            if (klass) palette.append(entry, static_cast<uint8_t>(klass));
+            out += static_cast<char>(entry.size());
+            out += entry;
+        }
+        std::fwrite(out.data(), 1, out.size(), file);
+    }
+    
+    // A size change must be followed by a frame that repaints every cell
+    void beginFrame(int frame_width, int frame_height) {
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        if (!started) last_time = now; // The trace starts at the first frame, not at startup
+        started = true;
+        record.clear();
+        if (frame_width != width || frame_height != height) {
+            width = frame_width;
+            height = frame_height;
+            record += 'S';
+            putVarint(record, width);
+            putVarint(record, height);
+        }
+        record += 'F';
+        putVarint(record, std::chrono::duration_cast<std::chrono::microseconds>(now - last_time).count());
+        last_time = now;
+        header_size = record.size();
+        runs = gap_start = 0;
+        in_run = false;
+    }
+    
+    // Repainted cells, in ascending index order
+    void cell(size_t index, uint8_t glyph, uint8_t klass) {
+        if (!in_run || index != run_end) {
+            closeRun();
+            in_run = true;
+            run_start = index;
+        }
+        body += static_cast<char>(glyph);
+        body += static_cast<char>(klass);
+        run_end = index + 1;
+    }
+    
+    void endFrame() {
+        closeRun();
+        std::string run_count;
+        putVarint(run_count, runs);
+        record.insert(header_size, run_count);
+        std::fwrite(record.data(), 1, record.size(), file);
+    }
+};
+
+// Streams a recorded trace to the terminal at its original pace, with no simulation
+inline int replayRecording(const std::string& path) {
+    FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) {
+        std::cerr << "Cannot open " << path << std::endl;
+        return 1;
+    }
+    std::string data;
+    char chunk[1 << 16];
+    for (size_t n; (n = std::fread(chunk, 1, sizeof(chunk), file)) > 0;) data.append(chunk, n);
+    std::fclose(file);
+    
+    size_t pos = 0;
+    bool truncated = false;
+    auto byte = [&]() -> uint8_t {
+        if (pos >= data.size()) {
+            truncated = true;
+            return 0;
+        }
+        return static_cast<uint8_t>(data[pos++]);
+    };
+    auto varint = [&]() -> uint64_t {
+        uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            uint8_t b = byte();
+            value |= static_cast<uint64_t>(b & 0x7f) << shift;
+            if (!(b & 0x80) || truncated) break;
+        }
+        return value;
+    };
+    
+    auto strings = [&](std::vector<std::string>& table) {
+        table.assign(static_cast<size_t>(varint()), std::string());
+        for (std::string& s : table) {
+            uint8_t length = byte();
+            for (uint8_t k = 0; k < length; ++k) s += static_cast<char>(byte());
+        }
+    };
+    
+    if (data.compare(0, 4, "MXRC") != 0 || data.size() < 5 || data[4] != 2) {
+        std::cerr << path << " is not a Matrix recording" << std::endl;
+        return 1;
+    }
+    pos = 5;
+    std::vector<std::string> glyphs, colors;
+    strings(glyphs);
+    
+#ifdef _WIN32
+    enableConsoleVT();
+#else
+    for (int sig : {SIGINT, SIGTERM}) signal(sig, onFatalSignal);
+#endif
+    std::string out = "\033[2J\033[?25l";
+    long long frames = 0, bytes = 0, width = 0, height = 0;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now(), due = start;
+    while (pos < data.size() && !truncated) {
+        char tag = static_cast<char>(byte());
+        if (tag == 'P') {
+            strings(colors);
+            continue;
+        }
+        if (tag == 'S') {
+            width = static_cast<long long>(varint());
+            height = static_cast<long long>(varint());
+            out += "\033[2J"; // The frame that follows repaints every cell
+            continue;
+        }
+        if (tag != 'F' || width <= 0) break;
+        due += std::chrono::microseconds(varint());
+        int level = -1;
+        size_t cursor = 0, index = 0;
+        for (uint64_t runs = varint(); runs > 0 && !truncated; --runs) {
+            index += varint();
+            for (uint64_t length = varint(); length > 0 && !truncated; --length, ++index) {
+                uint8_t glyph = byte(), klass = byte();
+                int row = static_cast<int>(index / width), col = static_cast<int>(index % width);
+                if (row >= height) continue;
+                if (index != cursor || col == 0) appendCursorMove(out, row, col);
+                bool lit = glyph && klass && klass < colors.size() && glyph < glyphs.size();
+                if (lit && klass != level) {
+                    out += colors[klass];
+                    level = klass;
+                }
+                out += lit ? glyphs[glyph] : std::string(" ");
+                cursor = index + 1;
+            }
+        }
+        std::this_thread::sleep_until(due);
+        writeStdout(out.data(), out.size());
+        bytes += static_cast<long long>(out.size());
+        out.clear();
+        ++frames;
+    }
+    out = "\033[0m\033[?25h";
+    appendCursorMove(out, static_cast<int>(height > 0 ? height - 1 : 0), 0);
+    out += "\n";
+    writeStdout(out.data(), out.size());
+    
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Replayed " << frames << " frames, " << bytes << " bytes";
+    if (elapsed > 0) std::cout << " (" << frames / elapsed << " fps)";
+    std::cout << (truncated ? ", recording truncated" : "") << ".\n";
+    return 0;
+}
+
+struct MatrixOptions {
+    bool sparse = false; // Drop-centric simulation, see Matrix::cellBrightness()
+    int fps = 60;        // Render rate; the simulation always ticks every SIM_STEP
+    int threads = 0;     // Worker threads for update/render; 0 picks from the screen size
+    ColorDepth colors = ColorDepth::Auto;
+    bool headless = false; // Compose frames in memory only; see Matrix::bench()
+    int width = 0, height = 0; // Grid size when headless (otherwise the terminal's)
+    std::string record_path;   // Trace every frame's changed cells here; see FrameRecorder
+    bool stats = false;        // Start with the counter status line shown ('s' toggles it)
+};
+
+template <typename Config>
+class BasicMatrix {
 private:
+    Config cfg;
     int width, height;
-    std::vector<std::vector<char>> screen;
-    std::vector<std::vector<int>> brightness; // For fading effect
+    Grid<uint8_t> screen; // Index into glyph_table; 0 is blank
+    Grid<uint8_t> brightness; // For fading effect, 0..cfg.max_brightness
     std::vector<int> drops;
     std::vector<int> speeds;
     std::vector<int> lengths;
     std::vector<int> counters; // For speed control
-    std::mt19937 rng;
-    std::uniform_int_distribution<int> char_dist;
-    std::uniform_int_distribution<int> speed_dist;
-    std::uniform_int_distribution<int> length_dist;
-    std::uniform_int_distribution<int> spawn_dist;
+    Grid<uint8_t> shown_screen; // What the terminal currently displays
+    Grid<uint8_t> shown_level; // Palette color class, 0 = blank
+    bool full_redraw = true;
+    std::string frame; // Composed frame, sent to the terminal in one write per render()
+    int current_level = -1; // SGR color the terminal was last left in (-1 = unknown)
+    Palette palette; // Active palette: rich_palette, or lean_palette under backpressure
+    Palette rich_palette, lean_palette;
+    
+    // Columns are independent, so update() runs column tiles and render() runs row bands
+    // (column tiles in sparse mode) on the pool; each tile draws from its own RNG stream
+    std::unique_ptr<WorkerPool> pool;
+    int tiles = 1;
+    std::vector<MatrixRng> tile_rngs;
+    std::vector<FrameBand> bands;
+    
+    // Sparse mode: no per-tick fade pass. Each cell keeps the brightness it was written
+    // with and the tick it was written on; its current value is derived on demand, and
+    // only each column's live row range [live_top, live_bottom] is ever visited.
+    bool sparse;
+    int target_fps;
+    bool headless;
+    size_t frame_bytes = 0; // Size of the last composed frame
+    std::unique_ptr<FrameRecorder> recorder;
+    std::vector<PaintedCell> recorded; // This frame's cells in row-major order, for recorder
+    
+    // Adaptive quality: when the terminal falls behind, run() steps quality_drop up
+    // (1: every other frame, 2: + 16-color palette, 3: + sparser rain) and back down once
+    // output has kept up for a while. See adaptQuality().
+    OutputQueue output;
+    std::chrono::steady_clock::duration write_time{}; // Time the last frame spent in output.push()
+    int quality_drop = 0;
+    int pressured_frames = 0, clear_frames = 0;
+    int idle_rows = 0; // Extra rows a respawned drop waits above the screen
     
-    // Matrix characters (mix of katakana, numbers, and symbols)
-    const std::string matrix_chars = "アイウエオカキクケコサシスセソタチツテトナニヌネノハヒフヘホマミムメモヤユヨラリルレロワヲン0123456789!@#$%^&*()";
+    // Hot-path counters: update() and render() add into pending_stats; run() folds each
+    // rendered frame into stats_window and every half second publishes the window's
+    // per-frame averages as shown_stats, drawn on the bottom row while status_rows is 1
+    std::vector<FrameStats> tile_stats; // One per update tile, folded in by update()
+    FrameStats pending_stats, stats_window, shown_stats;
+    bool count_faded = false; // Run the fade census; only worth its pass while shown
+    std::atomic<bool> show_stats{false}; // Flipped by the input thread on 's'
+    int status_rows = 0;
+#ifdef _WIN32
+    // Consoles without VT processing (conhost before Windows 10) get the whole frame as a
+    // CHAR_INFO block in one WriteConsoleOutputW call instead of an escape stream
+    bool vt_output = true;
+    std::vector<CHAR_INFO> console_cells;
+    COORD window_origin = {0, 0};
+#endif
+    uint32_t tick = 0;
+    Grid<uint32_t> stamp;
+    std::vector<int> live_top, live_bottom;
+    std::vector<int> shown_top, shown_bottom; // Live ranges as of the last render()
+    std::atomic<bool> key_pressed{false}; // Set by the input thread, polled by run()
+    std::atomic<bool> stop_input{false};
+    std::thread input_thread;
+    MatrixRng rng;
+    FastRange char_dist;
+    FastRange speed_dist;
+    FastRange length_dist;
+    FastRange spawn_dist;
+    
+    // Matrix characters (mix of katakana, numbers, and symbols). Half-width katakana so
+    // every glyph occupies exactly one terminal column.
+    const std::string matrix_chars = "ｱｲｳｴｵｶｷｸｹｺｻｼｽｾｿﾀﾁﾂﾃﾄﾅﾆﾇﾈﾉﾊﾋﾌﾍﾎﾏﾐﾑﾒﾓﾔﾕﾖﾗﾘﾙﾚﾛﾜｦﾝ0123456789!@#$%^&*()";
+    const std::vector<Glyph> glyph_table = buildGlyphTable(matrix_chars);
 
 public:
-    Matrix() : rng(std::chrono::steady_clock::now().time_since_epoch().count()) {
-        getTerminalSize();
+    static constexpr std::chrono::milliseconds SIM_STEP{8}; // One update() per step
+    static constexpr int TRAIL_CAP = 64; // Longest trail any config may ask for
+    static constexpr int SPAWN_CAP = 1 << 16; // Most extra rows a respawn may wait; keeps drop rows far from INT_MIN
+    
+    explicit BasicMatrix(const MatrixOptions& options = MatrixOptions(), const Config& config = Config())
+        : cfg(config), palette(options.colors, config.max_brightness), rich_palette(palette),
+          lean_palette(ColorDepth::Basic16, config.max_brightness), sparse(options.sparse),
+          target_fps(std::max(1, options.fps)),
+          headless(options.headless), show_stats(options.stats),
+          rng(static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count())) {
+        if (headless) {
+            width = std::max(1, options.width);
+            height = std::max(1, options.height);
+        } else {
+            getTerminalSize();
+        }
+        int threads = options.threads;
+        if (threads <= 0) {
+            // Roughly one thread per 16K cells; small terminals stay single-threaded
+            int hardware = std::max(1u, std::thread::hardware_concurrency());
+            threads = std::min(hardware, std::max(1, width * height / 16384));
+        }
+        pool.reset(new WorkerPool(threads));
         initializeMatrix();
+        if (!options.record_path.empty()) {
+            recorder.reset(new FrameRecorder(options.record_path, glyph_table));
+            recorder->setPalette(palette);
+        }
+    }
+    
+    ~BasicMatrix() {
+        stopInputThread();
+        leaveRawMode();
     }
     
     void getTerminalSize() {
 #ifdef _WIN32
-        CONSOLE_SCREEN_BUFFER_INFO csbi;
+        CONSOLE_SCREEN_BUFFER_INFO csbi = {};
         GetConsoleScreenBufferInfo(GetStdHandle(STD_OUTPUT_HANDLE), &csbi);
         width = csbi.srWindow.Right - csbi.srWindow.Left + 1;
         height = csbi.srWindow.Bottom - csbi.srWindow.Top + 1;
+        window_origin = {csbi.srWindow.Left, csbi.srWindow.Top};
 #else
-        struct winsize w;
+        struct winsize w = {};
         ioctl(STDOUT_FILENO, TIOCGWINSZ, &w);
         width = w.ws_col;
         height = w.ws_row;
 #endif
+        if (width <= 0 || height <= 0) {
+            width = 80; // Not a terminal
+            height = 24;
+        }
     }
     
     void initializeMatrix() {
-        screen.resize(height, std::vector<char>(width, ' '));
-        brightness.resize(height, std::vector<int>(width, 0));
+        screen.assign(width, height, 0);
+        brightness.assign(width, height, 0);
+        shown_screen.assign(width, height, 0);
+        shown_level.assign(width, height, 0);
+        if (sparse) {
+            stamp.assign(width, height, 0);
+            live_top.assign(width, height);
+            live_bottom.assign(width, -1);
+            shown_top = live_top;
+            shown_bottom = live_bottom;
+        }
+        full_redraw = true;
         drops.resize(width);
         speeds.resize(width);
         lengths.resize(width);
         counters.resize(width);
         
-        char_dist = std::uniform_int_distribution<int>(0, matrix_chars.length() - 1);
-        speed_dist = std::uniform_int_distribution<int>(1, 4); // Faster speeds
-        length_dist = std::uniform_int_distribution<int>(7, 10); // Shorter trails
-        spawn_dist = std::uniform_int_distribution<int>(0, 50); // More frequent spawning
+        char_dist = FastRange(1, static_cast<int>(glyph_table.size()) - 1);
+        speed_dist = FastRange(cfg.min_speed, cfg.max_speed);
+        length_dist = FastRange(cfg.min_trail, cfg.max_trail);
+        spawn_dist = FastRange(0, cfg.max_spawn);
         
         // Initialize drops - start them above screen
-        for (int i = 0; i < width; ++i) {
-            drops[i] = -spawn_dist(rng) - length_dist(rng); // Start above screen
-            speeds[i] = speed_dist(rng);
-            lengths[i] = length_dist(rng);
-            counters[i] = 0;
+        for (int i = 0; i < width; ++i) spawnDrop(i);
+        tile_rngs.clear();
+        configureTiles();
+    }
+    
+    void spawnDrop(int col) {
+        drops[col] = -spawn_dist(rng) - length_dist(rng); // Start above screen
+        speeds[col] = speed_dist(rng);
+        lengths[col] = length_dist(rng);
+        counters[col] = 0;
+    }
+    
+    void configureTiles() {
+        frame.reserve(static_cast<size_t>(width) * height * 12 + 64);
+        tiles = std::max(1, std::min(width, pool->size() > 1 ? pool->size() * 4 : 1));
+        bands.resize(tiles);
+        tile_stats.assign(tiles, FrameStats());
+        for (FrameBand& band : bands) band.out.reserve(static_cast<size_t>(width) * height * 12 / tiles + 64);
+        uint64_t seed = rng();
+        while (static_cast<int>(tile_rngs.size()) < tiles) tile_rngs.emplace_back(splitmix64(seed));
+    }
+    
+    // Adopts the current terminal size without rebuilding the engine: grids are reshaped
+    // in place, surviving columns keep their drops, and the next frame repaints fully
+    void resize() {
+        int old_width = width, old_height = height;
+        getTerminalSize();
+        if (width == old_width && height == old_height) return;
+        
+        screen.reshape(width, height, 0);
+        brightness.reshape(width, height, 0);
+        shown_screen.reshape(width, height, 0);
+        shown_level.reshape(width, height, 0);
+        drops.resize(width);
+        speeds.resize(width);
+        lengths.resize(width);
+        counters.resize(width);
+        for (int col = old_width; col < width; ++col) spawnDrop(col);
+        if (sparse) {
+            stamp.reshape(width, height, 0);
+            live_top.resize(width, height);
+            live_bottom.resize(width, -1);
+            for (int col = 0; col < width; ++col) {
+                live_bottom[col] = std::min(live_bottom[col], height - 1);
+                if (live_top[col] > live_bottom[col]) {
+                    live_top[col] = height;
+                    live_bottom[col] = -1;
+                }
+            }
+            shown_top = live_top;
+            shown_bottom = live_bottom;
         }
+        configureTiles();
+        full_redraw = true;
     }
     
     void clearScreen() {
@@ -104,19 +1140,27 @@ public:
 #endif
     }
     
-    void setGreenText(int brightness_level) {
+    void appendColor(FrameBand& band, int level) const {
+        if (level == band.level) return;
+        palette.append(band.out, static_cast<uint8_t>(level));
+        band.level = level;
+        ++band.escapes;
+    }
+    
+    static void appendCursorMove(FrameBand& band, int row, int col) {
+        ::appendCursorMove(band.out, row, col);
+        ++band.escapes;
+    }
+    
+    void writeOut(const char* data, size_t size) {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        output.push(data, size);
+        write_time = std::chrono::steady_clock::now() - start;
+    }
+    
+    void enableVirtualTerminal() {
 #ifdef _WIN32
-        if (brightness_level > 5) {
-            SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE), FOREGROUND_GREEN | FOREGROUND_INTENSITY);
-        } else {
-            SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE), FOREGROUND_GREEN);
-        }
-#else
-        if (brightness_level > 5) {
-            std::cout << "\033[92m"; // Bright green
-        } else {
-            std::cout << "\033[32m"; // Dim green
-        }
+        vt_output = enableConsoleVT();
 #endif
     }
     
@@ -128,50 +1172,147 @@ public:
 #endif
     }
     
-    bool kbhit() {
+    void enterRawMode() {
+#ifndef _WIN32
+        // Switch off line buffering and echo once for the whole run, not once per frame
+        if (raw_mode_active || tcgetattr(STDIN_FILENO, &saved_termios) != 0) return;
+        struct termios raw = saved_termios;
+        raw.c_lflag &= ~(ICANON | ECHO);
+        raw.c_cc[VMIN] = 1;
+        raw.c_cc[VTIME] = 0;
+        if (tcsetattr(STDIN_FILENO, TCSANOW, &raw) != 0) return;
+        raw_mode_active = 1;
+        std::atexit(restoreTerminal);
+        for (int sig : {SIGINT, SIGTERM, SIGHUP, SIGQUIT}) signal(sig, onFatalSignal);
+#endif
+    }
+    
+    void watchResize() {
+#ifndef _WIN32
+        struct sigaction winch = {};
+        winch.sa_handler = onResizeSignal;
+        winch.sa_flags = SA_RESTART;
+        sigaction(SIGWINCH, &winch, nullptr);
+#endif
+    }
+    
+    void leaveRawMode() {
+#ifndef _WIN32
+        restoreTerminal();
+#endif
+    }
+    
+    void startInputThread() {
+        key_pressed = false;
+        stop_input = false;
+        input_thread = std::thread([this] {
+#ifdef _WIN32
+            // The console has no resize signal, so watch the window size from here
+            HANDLE out = GetStdHandle(STD_OUTPUT_HANDLE);
+            CONSOLE_SCREEN_BUFFER_INFO last = {};
+            GetConsoleScreenBufferInfo(out, &last);
+#endif
+            while (!stop_input) {
 #ifdef _WIN32
-        return _kbhit();
+                CONSOLE_SCREEN_BUFFER_INFO now;
+                if (GetConsoleScreenBufferInfo(out, &now) &&
+                    (now.srWindow.Right - now.srWindow.Left != last.srWindow.Right - last.srWindow.Left ||
+                     now.srWindow.Bottom - now.srWindow.Top != last.srWindow.Bottom - last.srWindow.Top)) {
+                    last = now;
+                    resize_pending = true;
+                }
+                if (_kbhit()) {
+                    int ch = _getch();
+                    if (ch == 's' || ch == 'S') {
+                        show_stats = !show_stats;
+                        continue;
+                    }
+                    key_pressed = true;
+                    return;
+                }
+                Sleep(20);
 #else
-        struct termios oldt, newt;
-        int ch;
-        int oldf;
-        
-        tcgetattr(STDIN_FILENO, &oldt);
-        newt = oldt;
-        newt.c_lflag &= ~(ICANON | ECHO);
-        tcsetattr(STDIN_FILENO, TCSANOW, &newt);
-        oldf = fcntl(STDIN_FILENO, F_GETFL, 0);
-        fcntl(STDIN_FILENO, F_SETFL, oldf | O_NONBLOCK);
-        
-        ch = getchar();
-        
-        tcsetattr(STDIN_FILENO, TCSANOW, &oldt);
-        fcntl(STDIN_FILENO, F_SETFL, oldf);
-        
-        if (ch != EOF) {
-            ungetc(ch, stdin);
-            return true;
-        }
-        return false;
+                // Wake up periodically so stopInputThread() never waits on a silent stdin
+                struct pollfd pfd = {STDIN_FILENO, POLLIN, 0};
+                int ready = poll(&pfd, 1, 50);
+                if (ready < 0 && errno != EINTR) return;
+                if (ready <= 0) continue;
+                char ch;
+                ssize_t n = read(STDIN_FILENO, &ch, 1);
+                // stdin may share stdout's file description, and so its O_NONBLOCK
+                if (n < 0 && (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK)) continue;
+                if (n != 1) return; // EOF: no keyboard to wait on
+                if (ch == 's' || ch == 'S') {
+                    show_stats = !show_stats;
+                    continue;
+                }
+                key_pressed = true;
+                return;
 #endif
+            }
+        });
+    }
+    
+    void stopInputThread() {
+        stop_input = true;
+        if (input_thread.joinable()) input_thread.join();
+    }
+    
+    bool kbhit() const {
+        return key_pressed.load(std::memory_order_relaxed);
+    }
+    
+    int cellBrightness(int row, int col) const {
+        if (!sparse) return brightness(row, col);
+        uint32_t age = tick - stamp(row, col);
+        if (age > static_cast<uint32_t>(cfg.max_brightness / cfg.fade_step)) return 0; // Fully faded
+        int level = brightness(row, col) - cfg.fade_step * static_cast<int>(age);
+        return level > 0 ? level : 0;
+    }
+    
+    void setCell(int row, int col, uint8_t glyph, int level) {
+        screen(row, col) = glyph;
+        brightness(row, col) = static_cast<uint8_t>(level);
+        if (!sparse) return;
+        stamp(row, col) = tick;
+        if (live_top[col] > live_bottom[col]) {
+            live_top[col] = live_bottom[col] = row;
+        } else {
+            live_top[col] = std::min(live_top[col], row);
+            live_bottom[col] = std::max(live_bottom[col], row);
+        }
     }
     
     void update() {
-        // Fade all characters faster
-        for (int row = 0; row < height; ++row) {
-            for (int col = 0; col < width; ++col) {
-                if (brightness[row][col] > 0) {
-                    brightness[row][col] -= 3; // Faster fading
-                    if (brightness[row][col] <= 0) {
-                        brightness[row][col] = 0;
-                        screen[row][col] = ' ';
-                    }
+        ++tick;
+        pool->run(tiles, [this](int tile) { updateTile(tile); });
+        for (FrameStats& stats : tile_stats) {
+            pending_stats.add(stats);
+            stats = FrameStats();
+        }
+    }
+    
+    void updateTile(int tile) {
+        int first = width * tile / tiles, last = width * (tile + 1) / tiles;
+        MatrixRng& tile_rng = tile_rngs[tile];
+        FrameStats& stats = tile_stats[tile];
+        int glyph_picks[TRAIL_CAP];
+        
+        // Fade all characters faster, streaming through both grids linearly
+        if (!sparse) {
+            if (tiles == 1) {
+                if (count_faded) stats.faded += countLit(brightness.data(), brightness.size());
+                fadeCells(brightness.data(), screen.data(), brightness.size(), cfg.fade_step);
+            } else {
+                for (int row = 0; row < height; ++row) {
+                    if (count_faded) stats.faded += countLit(brightness.row(row) + first, last - first);
+                    fadeCells(brightness.row(row) + first, screen.row(row) + first, last - first, cfg.fade_step);
                 }
             }
         }
         
         // Update each column
-        for (int col = 0; col < width; ++col) {
+        for (int col = first; col < last; ++col) {
             counters[col]++;
             
             // Only move drop when counter reaches speed threshold
@@ -179,56 +1320,305 @@ public:
                 counters[col] = 0;
                 drops[col]++;
                 
+                // One batch of glyphs for the head and every tail cell that may repaint
+                char_dist.fill(tile_rng, glyph_picks, lengths[col]);
+                stats.rng_draws += (lengths[col] + 1) / 2; // Two picks per generator output
+                
                 // Draw the head of the drop (brightest)
                 if (drops[col] >= 0 && drops[col] < height) {
-                    screen[drops[col]][col] = matrix_chars[char_dist(rng)];
-                    brightness[drops[col]][col] = 10; // Brightest
+                    setCell(drops[col], col, static_cast<uint8_t>(glyph_picks[0]), cfg.max_brightness); // Brightest
                 }
                 
-                // Draw the tail with fading brightness
-                for (int i = 1; i < lengths[col]; ++i) {
+                // Draw the tail with fading brightness (bounded by the config so it can unroll)
+                for (int i = 1; i < cfg.max_trail; ++i) {
+                    if (i >= lengths[col]) break;
                     int tail_row = drops[col] - i;
                     if (tail_row >= 0 && tail_row < height) {
-                        if (brightness[tail_row][col] < (10 - i)) {
-                            screen[tail_row][col] = matrix_chars[char_dist(rng)];
-                            brightness[tail_row][col] = std::max(1, 10 - i);
+                        if (cellBrightness(tail_row, col) < (cfg.max_brightness - i)) {
+                            setCell(tail_row, col, static_cast<uint8_t>(glyph_picks[i]), std::max(1, cfg.max_brightness - i));
                         }
                     }
                 }
                 
                 // Reset drop if it completely goes off screen
                 if (drops[col] - lengths[col] > height) {
-                    drops[col] = -spawn_dist(rng) - lengths[col];
-                    speeds[col] = speed_dist(rng);
-                    lengths[col] = length_dist(rng);
+                    drops[col] = -spawn_dist(tile_rng) - lengths[col] - idle_rows;
+                    speeds[col] = speed_dist(tile_rng);
+                    lengths[col] = length_dist(tile_rng);
+                    ++stats.drops_reset;
+                    stats.rng_draws += 3;
+                }
+            }
+            
+            // Sparse mode: drop fully faded cells from both ends of the live range
+            if (sparse) {
+                while (live_top[col] <= live_bottom[col] && cellBrightness(live_top[col], col) == 0) ++live_top[col];
+                while (live_top[col] <= live_bottom[col] && cellBrightness(live_bottom[col], col) == 0) --live_bottom[col];
+                if (live_top[col] > live_bottom[col]) {
+                    live_top[col] = height;
+                    live_bottom[col] = -1;
                 }
             }
         }
     }
     
+    uint8_t colorLevel(int brightness_level) const {
+        return palette.colorClass(brightness_level);
+    }
+    
+    void paintCell(FrameBand& band, int row, int col, uint8_t raw_glyph, int level_value) {
+        bool lit = raw_glyph != 0 && level_value > 0;
+        uint8_t glyph = lit ? raw_glyph : 0;
+        uint8_t level = lit ? colorLevel(level_value) : 0;
+        uint8_t& shown_glyph = shown_screen(row, col);
+        uint8_t& shown = shown_level(row, col);
+        ++band.scanned;
+        if (!full_redraw && glyph == shown_glyph && level == shown) return;
+        ++band.painted;
+        
+        if (row != band.cursor_row || col != band.cursor_col) appendCursorMove(band, row, col);
+        if (lit) appendColor(band, level); // Blanks keep whatever color is active
+        const Glyph& encoded = glyph_table[glyph];
+        band.out.append(encoded.bytes, encoded.length);
+        if (recorder) band.painted_cells.push_back({static_cast<uint32_t>(row * width + col), glyph, level});
+        shown_glyph = glyph;
+        shown = level;
+        band.cursor_row = row;
+        band.cursor_col = col + 1;
+    }
+    
+    void renderTile(int tile) {
+        FrameBand& band = bands[tile];
+        band.reset(tile == 0 ? current_level : -1);
+        int rows = height - status_rows; // The status line, when shown, owns the bottom row
+        if (sparse && !full_redraw) {
+            // Only cells inside this frame's or the last frame's live range can differ
+            int first = width * tile / tiles, last = width * (tile + 1) / tiles;
+            for (int col = first; col < last; ++col) {
+                int top = std::min(live_top[col], shown_top[col]);
+                int bottom = std::min(std::max(live_bottom[col], shown_bottom[col]), rows - 1);
+                for (int row = top; row <= bottom; ++row) {
+                    paintCell(band, row, col, screen(row, col), cellBrightness(row, col));
+                }
+                shown_top[col] = live_top[col];
+                shown_bottom[col] = live_bottom[col];
+            }
+        } else {
+            int first = rows * tile / tiles, last = rows * (tile + 1) / tiles;
+            for (int row = first; row < last; ++row) {
+                const uint8_t* glyphs = screen.row(row);
+                const uint8_t* levels = brightness.row(row);
+                for (int col = 0; col < width; ++col) {
+                    int level = sparse ? cellBrightness(row, col) : levels[col];
+                    paintCell(band, row, col, glyphs[col], level);
+                }
+            }
+        }
+    }
+    
+#ifdef _WIN32
+    void renderConsole() {
+        const WORD dim = FOREGROUND_GREEN, bright = FOREGROUND_GREEN | FOREGROUND_INTENSITY;
+        const WORD plain = FOREGROUND_RED | FOREGROUND_GREEN | FOREGROUND_BLUE;
+        console_cells.resize(static_cast<size_t>(width) * height);
+        CHAR_INFO* cell = console_cells.data();
+        // The console is repainted whole, so every frame is traced whole too
+        if (recorder) recorder->beginFrame(width, height);
+        size_t index = 0;
+        for (int row = 0; row < height; ++row) {
+            for (int col = 0; col < width; ++col, ++cell, ++index) {
+                uint8_t glyph = screen(row, col);
+                int level = cellBrightness(row, col);
+                bool lit = glyph != 0 && level > 0;
+                uint32_t cp = glyph_table[lit ? glyph : 0].codepoint;
+                cell->Char.UnicodeChar = static_cast<WCHAR>(cp < 0x10000 ? cp : '?');
+                cell->Attributes = lit ? (level > cfg.max_brightness / 2 ? bright : dim) : plain;
+                if (recorder) recorder->cell(index, lit ? glyph : 0, lit ? colorLevel(level) : 0);
+            }
+        }
+        if (recorder) recorder->endFrame();
+        if (status_rows) {
+            std::string text = statusText();
+            CHAR_INFO* status = console_cells.data() + static_cast<size_t>(height - 1) * width;
+            for (int col = 0; col < width; ++col) {
+                status[col].Char.UnicodeChar = static_cast<WCHAR>(static_cast<unsigned char>(text[col]));
+                status[col].Attributes = BACKGROUND_RED | BACKGROUND_GREEN | BACKGROUND_BLUE;
+            }
+        }
+        COORD size = {static_cast<SHORT>(width), static_cast<SHORT>(height)};
+        COORD origin = {0, 0};
+        SMALL_RECT region = {window_origin.X, window_origin.Y,
+                             static_cast<SHORT>(window_origin.X + width - 1),
+                             static_cast<SHORT>(window_origin.Y + height - 1)};
+        WriteConsoleOutputW(GetStdHandle(STD_OUTPUT_HANDLE), console_cells.data(), size, origin, &region);
+        frame_bytes = console_cells.size() * sizeof(CHAR_INFO);
+        pending_stats.painted += console_cells.size();
+        pending_stats.bytes += frame_bytes;
+        ++pending_stats.writes;
+        full_redraw = false;
+    }
+#endif
+    
+    // Traces the cells paintCell() emitted this frame. Row bands arrive in order already;
+    // sparse mode walks column tiles, so its cells need sorting into row-major order.
+    void recordFrame() {
+        recorded.clear();
+        for (int tile = 0; tile < tiles; ++tile) {
+            recorded.insert(recorded.end(), bands[tile].painted_cells.begin(), bands[tile].painted_cells.end());
+        }
+        auto by_index = [](const PaintedCell& a, const PaintedCell& b) { return a.index < b.index; };
+        if (!std::is_sorted(recorded.begin(), recorded.end(), by_index)) {
+            std::sort(recorded.begin(), recorded.end(), by_index);
+        }
+        recorder->beginFrame(width, height);
+        for (const PaintedCell& cell : recorded) recorder->cell(cell.index, cell.glyph, cell.klass);
+        recorder->endFrame();
+    }
+    
     void render() {
-        // Move cursor to top-left
 #ifdef _WIN32
-        COORD coord = {0, 0};
-        SetConsoleCursorPosition(GetStdHandle(STD_OUTPUT_HANDLE), coord);
-#else
-        std::cout << "\033[H";
+        if (!vt_output && !headless) {
+            renderConsole();
+            return;
+        }
 #endif
+        // Only repaint cells whose glyph or color differs from what is on screen
+        if (full_redraw) current_level = -1;
+        pool->run(tiles, [this](int tile) { renderTile(tile); });
+        if (recorder) recordFrame();
+        if (sparse && full_redraw) {
+            shown_top = live_top;
+            shown_bottom = live_bottom;
+        }
+        full_redraw = false;
         
-        // Render screen with brightness levels
-        for (int row = 0; row < height; ++row) {
-            for (int col = 0; col < width; ++col) {
-                if (screen[row][col] != ' ' && brightness[row][col] > 0) {
-                    setGreenText(brightness[row][col]);
-                    std::cout << screen[row][col];
-                    resetColor();
-                } else {
-                    std::cout << ' ';
-                }
+        // Join the bands into one write; the terminal ends in the last color any band set
+        std::string* out = &bands[0].out;
+        if (tiles > 1) {
+            frame.clear();
+            for (const FrameBand& band : bands) frame += band.out;
+            out = &frame;
+        }
+        for (const FrameBand& band : bands) {
+            if (band.level != -1) current_level = band.level;
+            pending_stats.painted += band.painted;
+            pending_stats.escapes += band.escapes;
+        }
+        if (status_rows) {
+            ::appendCursorMove(*out, height - 1, 0);
+            *out += "\033[0;7m"; // Inverse video, whatever the palette
+            *out += statusText();
+            *out += "\033[0m";
+            current_level = -1;
+            pending_stats.escapes += 3;
+        }
+        frame_bytes = out->size();
+        pending_stats.bytes += frame_bytes;
+        if (!headless && !out->empty()) writeOut(out->data(), out->size());
+    }
+    
+    // shown_stats as one line, padded or cut to the screen width
+    std::string statusText() const {
+        const FrameStats& st = shown_stats;
+        double n = static_cast<double>(std::max<uint64_t>(1, st.frames));
+        auto ms = [&](std::chrono::steady_clock::duration d) {
+            return std::chrono::duration<double, std::milli>(d).count() / n;
+        };
+        char line[256];
+        int length = std::snprintf(line, sizeof(line),
+                                   " per frame: update %.2f ms  render %.2f ms | faded %.0f painted %.0f esc %.0f"
+                                   " | drops %.0f rng %.0f | %.0f B %.1f writes | quality step %d | s hides",
+                                   ms(st.update_time), ms(st.render_time), st.faded / n, st.painted / n,
+                                   st.escapes / n, st.drops_reset / n, st.rng_draws / n, st.bytes / n,
+                                   st.writes / n, quality_drop);
+        std::string text(line, static_cast<size_t>(std::max(0, std::min<int>(length, sizeof(line) - 1))));
+        text.resize(width, ' ');
+        return text;
+    }
+    
+    // Shows or hides the status line; hiding it repaints the row it covered
+    void setStatusVisible(bool visible) {
+        if (height < 2) visible = false;
+        if (visible == (status_rows == 1)) return;
+        status_rows = visible ? 1 : 0;
+        count_faded = visible;
+        if (!visible) full_redraw = true;
+    }
+    
+    // Headless throughput run: update() + render() per frame, nothing reaches a terminal
+    void bench(long long frames) {
+        using clock = std::chrono::steady_clock;
+        count_faded = true;
+        pending_stats = FrameStats();
+        clock::duration update_time = clock::duration::zero(), render_time = clock::duration::zero();
+        unsigned long long bytes = 0, scanned = 0, painted = 0;
+        for (long long f = 0; f < frames; ++f) {
+            clock::time_point t0 = clock::now();
+            update();
+            clock::time_point t1 = clock::now();
+            render();
+            clock::time_point t2 = clock::now();
+            update_time += t1 - t0;
+            render_time += t2 - t1;
+            bytes += frame_bytes;
+            for (const FrameBand& band : bands) {
+                scanned += band.scanned;
+                painted += band.painted;
+            }
+        }
+        
+        double n = static_cast<double>(std::max(1LL, frames));
+        auto ns = [&](clock::duration d) { return std::chrono::duration<double, std::nano>(d).count() / n; };
+        std::printf("bench %dx%d, %lld frames, %d threads, %s, %s config\n", width, height, frames, pool->size(),
+                    sparse ? "sparse" : "dense",
+                    std::is_same<Config, RuntimeMatrixConfig>::value ? "runtime" : "compile-time");
+        std::printf("  update  %12.0f ns/frame\n", ns(update_time));
+        std::printf("  render  %12.0f ns/frame\n", ns(render_time));
+        std::printf("  output  %12.0f bytes/frame\n", bytes / n);
+        std::printf("  cells   %12.0f scanned, %.0f painted per frame\n", scanned / n, painted / n);
+        const FrameStats& st = pending_stats;
+        std::printf("  counts  %12.0f faded, %.0f escapes, %.1f drops reset, %.0f rng draws per frame\n",
+                    st.faded / n, st.escapes / n, st.drops_reset / n, st.rng_draws / n);
+    }
+    
+    void setQuality(int drop) {
+        bool lean = drop >= 2;
+        if (lean != (quality_drop >= 2)) {
+            palette = lean ? lean_palette : rich_palette;
+            current_level = -1; // Class numbers now name other colors
+            // Lit cells on screen still show the old palette: give them a class no palette
+            // has, so paintCell() repaints exactly those (blanks look the same either way)
+            uint8_t* shown = shown_level.data();
+            for (size_t i = 0, n = static_cast<size_t>(width) * height; i < n; ++i) {
+                if (shown[i]) shown[i] = 0xff;
+            }
+            if (recorder) recorder->setPalette(palette);
+        }
+        quality_drop = drop;
+        idle_rows = drop >= 3 ? height : 0;
+    }
+    
+    // Called once per frame slot. Pressure is a frame still queued when the next one is
+    // due, a write that blocked for half a frame interval, or a terminal driver holding
+    // more than a frame's worth of bytes. A few pressured slots in a row cost one quality
+    // step; two seconds without pressure win one back.
+    void adaptQuality(bool backlog, std::chrono::steady_clock::duration frame_interval) {
+        bool pressured = backlog || write_time * 2 > frame_interval ||
+                         output.kernelQueued() > std::max<size_t>(frame_bytes, 4096);
+        write_time = std::chrono::steady_clock::duration::zero();
+        if (pressured) {
+            clear_frames = 0;
+            if (++pressured_frames >= 3 && quality_drop < 3) {
+                setQuality(quality_drop + 1);
+                pressured_frames = 0;
+            }
+        } else {
+            pressured_frames = 0;
+            if (++clear_frames >= 2 * target_fps && quality_drop > 0) {
+                setQuality(quality_drop - 1);
+                clear_frames = 0;
             }
-            if (row < height - 1) std::cout << '\n';
         }
-        std::cout << std::flush;
     }
     
     void sleep_ms(int milliseconds) {
@@ -243,26 +1633,187 @@ public:
         clearScreen();
         hideCursor();
         
-        std::cout << "Matrix Digital Rain - Press any key to exit\n";
+        enableVirtualTerminal();
+        enterRawMode();
+        watchResize();
+        startInputThread();
+        std::cout << "Matrix Digital Rain - Press s for stats, any other key to exit\n" << std::flush;
         sleep_ms(2000);
         
+        // Fixed-timestep loop: the simulation advances in SIM_STEP ticks regardless of how
+        // long rendering takes; if rendering falls behind, frames are skipped, not ticks
+        using clock = std::chrono::steady_clock;
+        const clock::duration frame_interval = std::chrono::duration_cast<clock::duration>(
+            std::chrono::duration<double>(1.0 / target_fps));
+        const int max_catch_up = 8; // Cap on ticks per frame so a stall cannot snowball
+        clock::time_point start = clock::now(), last = start, next_frame = start;
+        clock::duration lag = clock::duration::zero();
+        long long frames = 0, ticks = 0, skipped = 0, held = 0, slot = 0;
+        int worst_quality = 0;
+        clock::time_point window_start = start;
+        uint64_t writes_before = output.writes;
+        output.enable();
+        
         while (!kbhit()) {
-            update();
-            render();
-            sleep_ms(8); // Even faster animation
+            if (resize_pending.exchange(false)) resize();
+            setStatusVisible(show_stats);
+            clock::time_point now = clock::now();
+            lag += now - last;
+            last = now;
+            int steps = 0;
+            while (lag >= SIM_STEP && steps < max_catch_up) {
+                update();
+                lag -= SIM_STEP;
+                ++steps;
+            }
+            clock::time_point updated = clock::now();
+            pending_stats.update_time += updated - now;
+            if (steps == max_catch_up) lag = clock::duration::zero();
+            ticks += steps;
+            
+            // Under backpressure, compose nothing until the terminal has taken the last frame;
+            // the next one is diffed against what was queued, so nothing is lost
+            bool backlog = !output.flush();
+            if (backlog || (quality_drop >= 1 && slot % 2 != 0)) {
+                ++held;
+            } else {
+                render();
+                ++frames;
+                pending_stats.render_time += clock::now() - updated;
+                pending_stats.writes += output.writes - writes_before;
+                writes_before = output.writes;
+                pending_stats.frames = 1;
+                stats_window.add(pending_stats);
+                pending_stats = FrameStats();
+                if (updated - window_start >= std::chrono::milliseconds(500)) {
+                    shown_stats = stats_window;
+                    stats_window = FrameStats();
+                    window_start = updated;
+                }
+            }
+            ++slot;
+            adaptQuality(backlog, frame_interval);
+            worst_quality = std::max(worst_quality, quality_drop);
+            
+            next_frame += frame_interval;
+            now = clock::now();
+            if (next_frame < now) {
+                long long missed = (now - next_frame) / frame_interval + 1;
+                skipped += missed;
+                next_frame += missed * frame_interval;
+            }
+            std::this_thread::sleep_until(next_frame);
         }
+        double elapsed = std::chrono::duration<double>(clock::now() - start).count();
+        output.disable();
+        stopInputThread();
+        leaveRawMode();
         
         showCursor();
         resetColor();
         clearScreen();
         std::cout << "Matrix effect terminated.\n";
+        if (elapsed > 0) {
+            std::cout << "Rendered " << frames << " frames (" << frames / elapsed << " fps, target "
+                      << target_fps << "), " << ticks << " ticks, " << skipped << " frames skipped, "
+                      << held << " held back for output.\n";
+        }
+        if (worst_quality > 0) {
+            std::cout << "Output fell behind; quality was lowered by up to " << worst_quality << " of 3 steps.\n";
+        }
     }
 };
 
-int main() {
-    try {
-        Matrix matrix;
+#if __cplusplus < 201703L
+// Before C++17 static constexpr members are not implicitly inline, and run() ODR-uses these
+template <typename Config>
+constexpr std::chrono::milliseconds BasicMatrix<Config>::SIM_STEP;
+template <typename Config>
+constexpr int BasicMatrix<Config>::TRAIL_CAP;
+template <typename Config>
+constexpr int BasicMatrix<Config>::SPAWN_CAP;
+#endif
+
+using Matrix = BasicMatrix<DefaultMatrixConfig>;
+
+template <typename Config>
+void runMatrix(const MatrixOptions& options, const Config& config, long long frames) {
+    BasicMatrix<Config> matrix(options, config);
+    if (options.headless) {
+        matrix.bench(frames);
+    } else {
         matrix.run();
+    }
+}
+
+static bool parseRange(const char* text, int& low, int& high) {
+    return std::sscanf(text, "%d-%d", &low, &high) == 2 && low >= 1 && high >= low;
+}
+
+int main(int argc, char** argv) {
+    MatrixOptions options;
+    RuntimeMatrixConfig config;
+    bool tuned = false; // Any tuning flag switches to the runtime-config engine
+    long long frames = 1000;
+    std::string replay_path;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool ok = true;
+        if (arg == "--sparse") {
+            options.sparse = true; // Per-frame cost scales with live drops, not screen area
+        } else if (arg == "--fps" && i + 1 < argc) {
+            options.fps = std::atoi(argv[++i]);
+        } else if (arg == "--threads" && i + 1 < argc) {
+            options.threads = std::atoi(argv[++i]);
+        } else if (arg == "--colors" && i + 1 < argc) {
+            std::string depth = argv[++i];
+            options.colors = depth == "16" ? ColorDepth::Basic16
+                           : depth == "256" ? ColorDepth::Indexed256
+                           : depth == "truecolor" ? ColorDepth::TrueColor : ColorDepth::Auto;
+        } else if (arg == "--bench" && i + 1 < argc) {
+            options.headless = true;
+            ok = std::sscanf(argv[++i], "%dx%d", &options.width, &options.height) == 2;
+        } else if (arg == "--frames" && i + 1 < argc) {
+            frames = std::atoll(argv[++i]);
+        } else if (arg == "--stats") {
+            options.stats = true;
+        } else if (arg == "--record" && i + 1 < argc) {
+            options.record_path = argv[++i];
+        } else if (arg == "--replay" && i + 1 < argc) {
+            replay_path = argv[++i];
+        } else if (arg == "--speed" && i + 1 < argc) {
+            ok = tuned = parseRange(argv[++i], config.min_speed, config.max_speed);
+        } else if (arg == "--trail" && i + 1 < argc) {
+            ok = tuned = parseRange(argv[++i], config.min_trail, config.max_trail) &&
+                         config.max_trail <= Matrix::TRAIL_CAP;
+        } else if (arg == "--spawn" && i + 1 < argc) {
+            config.max_spawn = std::atoi(argv[++i]);
+            ok = tuned = config.max_spawn >= 0 && config.max_spawn <= Matrix::SPAWN_CAP;
+        } else if (arg == "--fade" && i + 1 < argc) {
+            config.fade_step = std::atoi(argv[++i]);
+            // fadeCells() takes the step as uint8_t; past max_brightness every step fades
+            // a cell out in one tick anyway, so larger values are rejected, not narrowed
+            ok = tuned = config.fade_step >= 1 && config.fade_step <= config.max_brightness;
+        } else {
+            ok = false;
+        }
+        if (!ok) {
+            std::cerr << "Usage: " << argv[0] << " [--sparse] [--fps N] [--threads N] [--colors 16|256|truecolor] [--stats]"
+                      << " [--bench WIDTHxHEIGHT [--frames N]]"
+                      << " [--speed MIN-MAX] [--trail MIN-MAX] [--spawn N] [--fade N]"
+                      << " [--record FILE | --replay FILE]" << std::endl;
+            return 1;
+        }
+    }
+    
+    if (!replay_path.empty()) return replayRecording(replay_path);
+    
+    try {
+        if (tuned) {
+            runMatrix(options, config, frames);
+        } else {
+            runMatrix(options, DefaultMatrixConfig(), frames);
+        }
     } catch (const std::exception& e) {
         std::cerr << "Error: " << e.what() << std::endl;
         return 1;
@@ -0,0 +1,480 @@
+// Fast stdin/stdout for the CP template: FastReader, FastWriter and a minimal span.
+// Header-only; include it next to code.cpp (or copy it beside a solution).
+#pragma once
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <type_traits>
+#include <iterator>
+#include <cstddef>
+#ifdef CP_PROFILE
+#include <chrono>
+#endif
+
+#ifdef _WIN32
+// This header comes first in code.cpp: keep windows.h's min/max macros away from std::min/max
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#include <io.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if __cplusplus >= 202002L && defined(__has_include)
+#if __has_include(<span>)
+#include <span>
+#define FASTIO_STD_SPAN 1
+#endif
+#endif
+
+#ifdef FASTIO_STD_SPAN
+using std::span;
+#else
+// Pointer + length view, enough of std::span for FastWriter::write before C++20
+template <class T>
+struct span
+{
+    T *p = nullptr;
+    size_t n = 0;
+
+    span() = default;
+    span(T *p, size_t n) : p(p), n(n) {}
+    template <class C, class = decltype(std::declval<C &>().data() + std::declval<C &>().size())>
+    span(C &c) : p(c.data()), n(c.size()) {}
+    T *data() const { return p; }
+    size_t size() const { return n; }
+    bool empty() const { return n == 0; }
+    T &operator[](size_t i) const { return p[i]; }
+    T *begin() const { return p; }
+    T *end() const { return p + n; }
+};
+#endif
+
+// Buffered reader over stdin: drop-in for `cin >>` on whitespace-separated tokens.
+// map_stdin() parses straight out of the page cache when stdin is a regular file.
+// Tokens are parsed with a raw pointer over the bytes in view; the buffered mode keeps
+// at least LOOKAHEAD bytes in view so a number never straddles a refill.
+struct FastReader
+{
+    static const size_t BUF = 1 << 16;
+    static const size_t LOOKAHEAD = 64;
+    char buf[BUF];
+    const char *data = buf;
+    size_t len = 0, pos = 0;
+    bool mapped = false;
+#ifdef _WIN32
+    HANDLE mapping = nullptr;
+#endif
+
+    bool map_stdin()
+    {
+#ifdef _WIN32
+        HANDLE file = (HANDLE)_get_osfhandle(_fileno(stdin));
+        LARGE_INTEGER size;
+        if (file == INVALID_HANDLE_VALUE || GetFileType(file) != FILE_TYPE_DISK) return false;
+        if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) return false;
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping) return false;
+        void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (!view) { CloseHandle(mapping); mapping = nullptr; return false; }
+        len = (size_t)size.QuadPart;
+#else
+        struct stat st;
+        int fd = fileno(stdin);
+        if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size == 0) return false;
+        void *view = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (view == MAP_FAILED) return false;
+        madvise(view, st.st_size, MADV_SEQUENTIAL);
+        len = (size_t)st.st_size;
+#endif
+        data = (const char *)view;
+        pos = 0;
+        mapped = true;
+        return true;
+    }
+    ~FastReader()
+    {
+        if (!mapped) return;
+#ifdef _WIN32
+        UnmapViewOfFile(data);
+        CloseHandle(mapping);
+#else
+        munmap((void *)data, len);
+#endif
+    }
+
+    // Tops the buffer up so at least `need` unread bytes are in view, unless input ends first
+    void ensure(size_t need)
+    {
+        if (mapped || len - pos >= need) return;
+        size_t rest = len - pos;
+        memmove(buf, buf + pos, rest);
+        len = rest + fread(buf + rest, 1, BUF - rest, stdin);
+        pos = 0;
+    }
+    int peek()
+    {
+        if (pos == len)
+        {
+            ensure(1);
+            if (pos == len) return EOF;
+        }
+        return (unsigned char)data[pos];
+    }
+    int get()
+    {
+        int c = peek();
+        if (c != EOF) pos++;
+        return c;
+    }
+    int skip()
+    {
+        int c = peek();
+        while (c != EOF && c <= ' ') { pos++; c = peek(); }
+        return c;
+    }
+
+    template <class T>
+    T read_int()
+    {
+        skip();
+        ensure(LOOKAHEAD);
+        const char *p = data + pos, *end = data + len;
+        bool neg = p < end && *p == '-';
+        p += neg || (p < end && *p == '+');
+        const char *digits = p;
+        typename std::make_unsigned<T>::type v = 0;
+        while (p < end && (unsigned)(*p - '0') < 10) v = v * 10 + (*p++ - '0');
+        bool any = p != digits;
+        pos = p - data;
+        if (p == end) // Overlong token: finish it through the refilling path
+            for (int c = peek(); c >= '0' && c <= '9'; c = peek()) { v = v * 10 + (c - '0'); pos++; any = true; }
+        if (!any) // Not a number: read as 0, but step past it so the next read moves on
+            while (peek() > ' ') pos++;
+        return neg ? (T)(0 - v) : (T)v;
+    }
+    static double parse_float(const char *s, double *) { return strtod(s, nullptr); }
+    static float parse_float(const char *s, float *) { return strtof(s, nullptr); }
+    static long double parse_float(const char *s, long double *) { return strtold(s, nullptr); }
+    template <class T>
+    T read_float()
+    {
+        char tmp[LOOKAHEAD];
+        size_t k = 0;
+        int c = skip();
+        for (; c > ' ' && k + 1 < sizeof(tmp); c = peek()) { tmp[k++] = (char)c; pos++; }
+        tmp[k] = 0;
+        if (c > ' ') // Overlong token: parse all of it, so the next read starts after it
+            return parse_float((std::string(tmp, k) + read_string()).c_str(), (T *)nullptr);
+        return parse_float(tmp, (T *)nullptr);
+    }
+    std::string read_string()
+    {
+        std::string s;
+        skip();
+        while (peek() != EOF)
+        {
+            const char *p = data + pos, *end = data + len;
+            while (p < end && (unsigned char)*p > ' ') p++;
+            s.append(data + pos, p);
+            pos = p - data;
+            if (p != end) break;
+        }
+        return s;
+    }
+
+    // read<T>() for integral, bool (0/1), floating-point, char and std::string tokens
+    template <class T>
+    typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, char>::value &&
+                                !std::is_same<T, bool>::value,
+                            T>::type
+    read()
+    {
+        return read_int<T>();
+    }
+    template <class T>
+    typename std::enable_if<std::is_same<T, bool>::value, T>::type read() { return read_int<int>() != 0; }
+    template <class T>
+    typename std::enable_if<std::is_floating_point<T>::value, T>::type read() { return read_float<T>(); }
+    template <class T>
+    typename std::enable_if<std::is_same<T, char>::value, T>::type read()
+    {
+        skip();
+        return (char)get();
+    }
+    template <class T>
+    typename std::enable_if<std::is_same<T, std::string>::value, T>::type read() { return read_string(); }
+
+    // Fills dst[0..n) in one pass
+    template <class T>
+    void read_vector(T *dst, size_t n)
+    {
+        for (size_t i = 0; i < n; i++) dst[i] = read<T>();
+    }
+    template <class T>
+    std::vector<T> read_vector(size_t n)
+    {
+        std::vector<T> v(n);
+        read_vector(v.data(), n);
+        return v;
+    }
+
+    template <class T>
+    FastReader &operator>>(T &x)
+    {
+        x = read<T>();
+        return *this;
+    }
+};
+
+// The next n tokens of type T, parsed only as they are consumed: `for (T x : a)`, next(),
+// or next_chunk() for a span of up to CHUNK values. At most one chunk is held in memory.
+template <class T>
+struct TokenStream
+{
+    static const size_t CHUNK = 4096;
+    FastReader &in;
+    size_t left;
+    T chunk[CHUNK];
+
+    TokenStream(FastReader &in, size_t n) : in(in), left(n) {}
+    size_t remaining() const { return left; }
+    T next()
+    {
+        left--;
+        return in.read<T>();
+    }
+    // Empty once all n tokens are consumed
+    span<const T> next_chunk()
+    {
+        size_t k = left < CHUNK ? left : CHUNK;
+        in.read_vector(chunk, k);
+        left -= k;
+        return span<const T>(chunk, k);
+    }
+    // Consumes whatever the solution left unread, so the reader lands on the next test
+    void skip_rest()
+    {
+        while (left) next();
+    }
+
+    struct iterator
+    {
+        typedef std::input_iterator_tag iterator_category;
+        typedef T value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const T *pointer;
+        typedef const T &reference;
+
+        TokenStream *s;
+        T value;
+        bool done;
+
+        const T &operator*() const { return value; }
+        iterator &operator++()
+        {
+            done = s->left == 0;
+            if (!done) value = s->next();
+            return *this;
+        }
+        bool operator==(const iterator &o) const { return done == o.done; }
+        bool operator!=(const iterator &o) const { return done != o.done; }
+    };
+    iterator begin()
+    {
+        iterator it{this, T(), false};
+        return ++it;
+    }
+    iterator end() { return iterator{this, T(), true}; }
+};
+
+// Buffered writer over stdout: flushes only when the buffer fills or at exit.
+// With `sink` set, flushes append to that string instead (per-test output in CP_PARALLEL).
+struct FastWriter
+{
+    static const size_t BUF = 1 << 16;
+    char buf[BUF];
+    size_t pos = 0;
+    char pairs[200];
+    std::string *sink = nullptr;
+    int precision = 6;  // Floating-point digits, as cout's setprecision()
+    bool fixed = false; // Digits after the point rather than significant digits, as cout << fixed
+#ifdef CP_PROFILE
+    double emit_ms = 0; // Time spent handing bytes to stdout, for the profile's write phase
+#endif
+
+    FastWriter()
+    {
+        for (int i = 0; i < 100; i++)
+        {
+            pairs[2 * i] = char('0' + i / 10);
+            pairs[2 * i + 1] = char('0' + i % 10);
+        }
+    }
+    ~FastWriter() { flush(); }
+
+    // Hands n bytes on to the sink or stdout (and stdout's own buffer with them)
+    void emit(const char *s, size_t n)
+    {
+        if (sink)
+        {
+            sink->append(s, n);
+            return;
+        }
+#ifdef CP_PROFILE
+        std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+#endif
+        if (n) fwrite(s, 1, n, stdout);
+        fflush(stdout);
+#ifdef CP_PROFILE
+        emit_ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+#endif
+    }
+    void flush()
+    {
+        emit(buf, pos);
+        pos = 0;
+    }
+    void reserve(size_t n)
+    {
+        if (pos + n > BUF) flush();
+    }
+    void put(char c)
+    {
+        reserve(1);
+        buf[pos++] = c;
+    }
+    void newline() { put('\n'); }
+    void write(const char *s, size_t n)
+    {
+        if (n > BUF)
+        {
+            flush();
+            emit(s, n);
+            return;
+        }
+        reserve(n);
+        memcpy(buf + pos, s, n);
+        pos += n;
+    }
+
+    // Elements separated by `sep`, then a newline
+    template <class T>
+    void write(span<const T> xs, char sep = ' ')
+    {
+        for (size_t i = 0; i < xs.size(); i++)
+        {
+            if (i) put(sep);
+            *this << xs[i];
+        }
+        newline();
+    }
+    template <class C, class T = typename std::remove_pointer<decltype(std::declval<const C &>().data())>::type>
+    void write(const C &xs, char sep = ' ')
+    {
+        write(span<const T>(xs.data(), xs.size()), sep);
+    }
+
+    // cout's fixed << setprecision(digits)
+    void set_fixed(int digits)
+    {
+        fixed = true;
+        precision = digits;
+    }
+
+    // char and bool have their own overloads below
+    template <class T, typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, char>::value &&
+                                                   !std::is_same<T, bool>::value,
+                                               int>::type = 0>
+    FastWriter &operator<<(T x)
+    {
+        reserve(24);
+        typename std::make_unsigned<T>::type v = x;
+        if (x < 0) { buf[pos++] = '-'; v = 0 - v; }
+        char tmp[24];
+        int k = 24;
+        while (v >= 100)
+        {
+            int r = int(v % 100);
+            v /= 100;
+            k -= 2;
+            tmp[k] = pairs[2 * r];
+            tmp[k + 1] = pairs[2 * r + 1];
+        }
+        if (v >= 10)
+        {
+            k -= 2;
+            tmp[k] = pairs[2 * v];
+            tmp[k + 1] = pairs[2 * v + 1];
+        }
+        else tmp[--k] = char('0' + v);
+        memcpy(buf + pos, tmp + k, 24 - k);
+        pos += 24 - k;
+        return *this;
+    }
+    int format(char *dst, size_t room, double x) const
+    {
+        return snprintf(dst, room, fixed ? "%.*f" : "%.*g", precision, x);
+    }
+    int format(char *dst, size_t room, long double x) const
+    {
+        return snprintf(dst, room, fixed ? "%.*Lf" : "%.*Lg", precision, x);
+    }
+    // Formatted in place as printf's %g (or %f once fixed is set)
+    template <class T, typename std::enable_if<std::is_floating_point<T>::value, int>::type = 0>
+    FastWriter &operator<<(T x)
+    {
+        reserve(32);
+        int n = format(buf + pos, BUF - pos, x);
+        if (n >= 0 && (size_t)n >= BUF - pos) // Did not fit: retry in an empty buffer
+        {
+            flush();
+            if ((size_t)n >= BUF) // Only a huge precision gets here
+            {
+                std::string tmp(n + 1, '\0');
+                format(&tmp[0], n + 1, x);
+                write(tmp.data(), n);
+                return *this;
+            }
+            n = format(buf, BUF, x);
+        }
+        if (n > 0) pos += n;
+        return *this;
+    }
+    FastWriter &operator<<(char c)
+    {
+        put(c);
+        return *this;
+    }
+    FastWriter &operator<<(bool b)
+    {
+        put(b ? '1' : '0');
+        return *this;
+    }
+    FastWriter &operator<<(const char *s)
+    {
+        write(s, strlen(s));
+        return *this;
+    }
+    FastWriter &operator<<(const std::string &s)
+    {
+        write(s.data(), s.size());
+        return *this;
+    }
+    // Anything else would silently convert to one of the overloads above (an enum or a
+    // pointer to bool, say), so it does not compile instead
+    template <class T, typename std::enable_if<!std::is_arithmetic<T>::value && !std::is_convertible<T, const char *>::value &&
+                                                   !std::is_convertible<const T &, std::string>::value,
+                                               int>::type = 0>
+    FastWriter &operator<<(const T &) = delete;
+};
@@ -0,0 +1,185 @@
+// Static graphs in CSR form for the CP template: every vertex's out-edges sit contiguously in
+// one `to` array (and one `weight` array), indexed by `start[v] .. start[v + 1]`. Everything
+// is carved from the per-test Arena, so a graph costs a handful of allocations, not one
+// vector per vertex, and is released by arena.reset() with the rest of the test.
+// Like algo.hpp this lives in namespace cp, leaving `graph`, `bfs` and `dfs` to solutions.
+#pragma once
+
+#include <cstddef>
+#include "arena.hpp"
+#include "fastio.hpp"
+
+namespace cp
+{
+
+// Out-neighbours of one vertex: `for (int u : g.adj(v))`
+struct csr_range
+{
+    const int *b, *e;
+    const int *begin() const { return b; }
+    const int *end() const { return e; }
+    size_t size() const { return e - b; }
+};
+
+struct graph
+{
+    int n;
+    arena_vector<int> start; // n + 1 offsets into `to`
+    arena_vector<int> to;
+
+    graph(Arena &A, int n, size_t edges) : n(n), start(A, n + 1), to(A, edges) {}
+    csr_range adj(int v) const { return {to.data() + start[v], to.data() + start[v + 1]}; }
+    int degree(int v) const { return start[v + 1] - start[v]; }
+    size_t edges() const { return to.size(); }
+};
+
+// Edge e = start[v] .. start[v + 1] - 1 runs v -> to[e] with weight[e]
+template <class W>
+struct weighted_graph : graph
+{
+    arena_vector<W> weight;
+
+    weighted_graph(Arena &A, int n, size_t edges) : graph(A, n, edges), weight(A, edges) {}
+};
+
+// Reads m edges "u v" (or "u v w" for a weighted graph) and builds the CSR arrays in two
+// passes over the edge list: count degrees while reading, then prefix-sum and fill. Vertices
+// are numbered from `base` in the input and from 0 in the graph; undirected edges are
+// stored in both directions. `weight` is the graph's weight array, or null. The edge list
+// is scratch and goes back to the arena once the CSR arrays are filled.
+template <class W>
+void read_csr(FastReader &in, Arena &A, graph &g, W *weight, size_t m, bool directed, int base)
+{
+    size_t scratch = A.mark();
+    int *eu = A.alloc<int>(m), *ev = A.alloc<int>(m);
+    W *ew = weight ? A.alloc<W>(m) : nullptr;
+    for (size_t i = 0; i < m; i++)
+    {
+        eu[i] = in.read<int>() - base;
+        ev[i] = in.read<int>() - base;
+        if (ew) ew[i] = in.read<W>();
+        g.start[eu[i] + 1]++;
+        if (!directed) g.start[ev[i] + 1]++;
+    }
+    for (int v = 0; v < g.n; v++) g.start[v + 1] += g.start[v];
+
+    int *fill = A.alloc<int>(g.n);
+    for (int v = 0; v < g.n; v++) fill[v] = g.start[v];
+    for (size_t i = 0; i < m; i++)
+    {
+        int e = fill[eu[i]]++;
+        g.to[e] = ev[i];
+        if (ew) weight[e] = ew[i];
+        if (directed) continue;
+        e = fill[ev[i]]++;
+        g.to[e] = eu[i];
+        if (ew) weight[e] = ew[i];
+    }
+    A.rollback(scratch);
+}
+
+inline graph read_graph(FastReader &in, Arena &A, int n, size_t m, bool directed = false, int base = 1)
+{
+    graph g(A, n, directed ? m : 2 * m);
+    read_csr(in, A, g, (int *)nullptr, m, directed, base);
+    return g;
+}
+
+template <class W>
+weighted_graph<W> read_weighted_graph(FastReader &in, Arena &A, int n, size_t m, bool directed = false, int base = 1)
+{
+    weighted_graph<W> g(A, n, directed ? m : 2 * m);
+    read_csr(in, A, g, g.weight.data(), m, directed, base);
+    return g;
+}
+
+// Breadth-first search from src: dist[v] = edges on a shortest path, -1 if unreachable.
+// The queue is a flat array of n vertices, handed back to the arena on return, so a bfs
+// from every vertex needs no more arena than one. Returns the number of vertices reached.
+inline int bfs(const graph &g, int src, arena_vector<int> &dist, Arena &A)
+{
+    size_t scratch = A.mark();
+    int *queue = A.alloc<int>(g.n);
+    for (int v = 0; v < g.n; v++) dist[v] = -1;
+    int head = 0, tail = 0;
+    dist[src] = 0;
+    queue[tail++] = src;
+    while (head < tail)
+    {
+        int v = queue[head++];
+        for (int u : g.adj(v))
+            if (dist[u] < 0)
+            {
+                dist[u] = dist[v] + 1;
+                queue[tail++] = u;
+            }
+    }
+    A.rollback(scratch);
+    return tail;
+}
+
+// Depth-first search without recursion: an explicit array stack of (vertex, next edge)
+// pairs, so deep paths cannot overflow the call stack. pre(v, parent) runs when v is first
+// reached (parent -1 for a root), post(v) once all its descendants are done. Both stacks
+// are n ints, since each vertex is pushed at most once.
+template <class Pre, class Post>
+void dfs_from(const graph &g, int src, char *seen, int *stack, int *next, Pre &pre, Post &post)
+{
+    if (seen[src]) return;
+    int top = 0;
+    seen[src] = 1;
+    pre(src, -1);
+    stack[top] = src;
+    next[top++] = g.start[src];
+    while (top)
+    {
+        int v = stack[top - 1];
+        if (next[top - 1] == g.start[v + 1])
+        {
+            post(v);
+            top--;
+            continue;
+        }
+        int u = g.to[next[top - 1]++];
+        if (seen[u]) continue;
+        seen[u] = 1;
+        pre(u, v);
+        stack[top] = u;
+        next[top++] = g.start[u];
+    }
+}
+
+// One tree from src; `seen` must be zeroed by the caller. The 8n bytes of stacks are
+// returned to the arena afterwards (as is anything pre/post allocate from it), and
+// dfs_all() sweeps every component in one go.
+template <class Pre, class Post>
+void dfs(const graph &g, int src, arena_vector<char> &seen, Arena &A, Pre pre, Post post)
+{
+    size_t scratch = A.mark();
+    int *stack = A.alloc<int>(g.n), *next = A.alloc<int>(g.n);
+    dfs_from(g, src, seen.data(), stack, next, pre, post);
+    A.rollback(scratch);
+}
+template <class Pre>
+void dfs(const graph &g, int src, arena_vector<char> &seen, Arena &A, Pre pre)
+{
+    dfs(g, src, seen, A, pre, [](int) {});
+}
+
+// The whole DFS forest, roots taken in vertex order; its scratch is released the same way
+template <class Pre, class Post>
+void dfs_all(const graph &g, Arena &A, Pre pre, Post post)
+{
+    size_t scratch = A.mark();
+    arena_vector<char> seen(A, g.n);
+    int *stack = A.alloc<int>(g.n), *next = A.alloc<int>(g.n);
+    for (int v = 0; v < g.n; v++) dfs_from(g, v, seen.data(), stack, next, pre, post);
+    A.rollback(scratch);
+}
+template <class Pre>
+void dfs_all(const graph &g, Arena &A, Pre pre)
+{
+    dfs_all(g, A, pre, [](int) {});
+}
+
+} // namespace cp
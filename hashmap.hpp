@@ -0,0 +1,262 @@
+// Flat open-addressing hash map/set for the CP template: flat_map<K, V> and flat_set<K>.
+// Drop-in for the common unordered_map/unordered_set subset. Slots live in one array
+// (linear probing, power-of-two capacity, load <= 1/2, backward-shift erase so there are no
+// tombstones), and the hash is salted per run so anti-hash tests cannot force collisions.
+// Keys and values must be default-constructible; iterators are invalidated by any insert
+// that grows the table and by erase.
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// splitmix64 over a per-process random seed: integers and pairs of them are mixed directly,
+// anything else goes through std::hash first
+struct anti_hack_hash
+{
+    static uint64_t mix(uint64_t x)
+    {
+        static const uint64_t seed = (uint64_t)std::chrono::steady_clock::now().time_since_epoch().count();
+        x += seed + 0x9e3779b97f4a7c15ULL;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
+    template <class T>
+    typename std::enable_if<std::is_integral<T>::value, uint64_t>::type operator()(T x) const
+    {
+        return mix((uint64_t)x);
+    }
+    template <class A, class B>
+    uint64_t operator()(const std::pair<A, B> &p) const
+    {
+        return mix((*this)(p.first) * 31 + (*this)(p.second));
+    }
+    template <class T>
+    typename std::enable_if<!std::is_integral<T>::value, uint64_t>::type operator()(const T &x) const
+    {
+        return mix(std::hash<T>()(x));
+    }
+};
+
+template <class K, class V, class Hash = anti_hack_hash>
+struct flat_map
+{
+    typedef K key_type;
+    typedef V mapped_type;
+    typedef std::pair<K, V> value_type;
+
+    std::vector<value_type> slots;
+    std::vector<uint8_t> used;
+    size_t count_ = 0, mask = 0;
+    Hash hasher;
+
+    template <class M, class P>
+    struct iter
+    {
+        M *m;
+        size_t i;
+
+        P &operator*() const { return m->slots[i]; }
+        P *operator->() const { return &m->slots[i]; }
+        iter &operator++()
+        {
+            ++i;
+            while (i < m->used.size() && !m->used[i]) ++i;
+            return *this;
+        }
+        bool operator==(const iter &o) const { return i == o.i; }
+        bool operator!=(const iter &o) const { return i != o.i; }
+    };
+    typedef iter<flat_map, value_type> iterator;
+    typedef iter<const flat_map, const value_type> const_iterator;
+
+    flat_map() = default;
+    explicit flat_map(size_t n) { reserve(n); }
+
+    size_t size() const { return count_; }
+    bool empty() const { return count_ == 0; }
+    size_t bucket_count() const { return slots.size(); }
+
+    iterator begin() { return ++iterator{this, size_t(-1)}; }
+    iterator end() { return iterator{this, used.size()}; }
+    const_iterator begin() const { return ++const_iterator{this, size_t(-1)}; }
+    const_iterator end() const { return const_iterator{this, used.size()}; }
+
+    void clear()
+    {
+        std::fill(used.begin(), used.end(), 0);
+        count_ = 0;
+    }
+    // Room for n keys without rehashing
+    void reserve(size_t n)
+    {
+        size_t cap = table_size(2 * n);
+        if (cap > slots.size()) resize_table(cap);
+    }
+    // At least n buckets, as unordered_map::rehash(); never below twice the current size
+    void rehash(size_t n)
+    {
+        size_t cap = table_size(std::max(n, 2 * count_));
+        if (cap != slots.size()) resize_table(cap);
+    }
+
+    // Smallest power of two >= n (and >= 8), so `mask` stays a valid probe mask
+    static size_t table_size(size_t n)
+    {
+        size_t cap = 8;
+        while (cap < n) cap <<= 1;
+        return cap;
+    }
+    // cap must come from table_size() and exceed count_
+    void resize_table(size_t cap)
+    {
+        std::vector<value_type> old_slots(cap);
+        std::vector<uint8_t> old_used(cap, 0);
+        old_slots.swap(slots);
+        old_used.swap(used);
+        mask = cap - 1;
+        for (size_t i = 0; i < old_used.size(); i++)
+        {
+            if (!old_used[i]) continue;
+            size_t j = home(old_slots[i].first);
+            while (used[j]) j = (j + 1) & mask;
+            slots[j] = std::move(old_slots[i]);
+            used[j] = 1;
+        }
+    }
+
+    size_t home(const K &key) const { return (size_t)hasher(key) & mask; }
+    // Slot holding `key`, or the empty slot where it would go
+    size_t probe(const K &key) const
+    {
+        size_t i = home(key);
+        while (used[i] && !(slots[i].first == key)) i = (i + 1) & mask;
+        return i;
+    }
+
+    iterator find(const K &key)
+    {
+        if (slots.empty()) return end();
+        size_t i = probe(key);
+        return used[i] ? iterator{this, i} : end();
+    }
+    const_iterator find(const K &key) const
+    {
+        if (slots.empty()) return end();
+        size_t i = probe(key);
+        return used[i] ? const_iterator{this, i} : end();
+    }
+    size_t count(const K &key) const { return find(key) != end(); }
+    bool contains(const K &key) const { return count(key) != 0; }
+
+    template <class... Args>
+    std::pair<iterator, bool> try_emplace(const K &key, Args &&...args)
+    {
+        // Grow only for a key that is really new, so hits never move existing entries
+        size_t i = slots.empty() ? 0 : probe(key);
+        if (!slots.empty() && used[i]) return {iterator{this, i}, false};
+        if (2 * (count_ + 1) > slots.size())
+        {
+            resize_table(slots.empty() ? 8 : 2 * slots.size());
+            i = probe(key);
+        }
+        slots[i] = value_type(key, V(std::forward<Args>(args)...));
+        used[i] = 1;
+        count_++;
+        return {iterator{this, i}, true};
+    }
+    std::pair<iterator, bool> insert(const value_type &kv) { return try_emplace(kv.first, kv.second); }
+    template <class... Args>
+    std::pair<iterator, bool> emplace(const K &key, Args &&...args)
+    {
+        return try_emplace(key, std::forward<Args>(args)...);
+    }
+    V &operator[](const K &key) { return try_emplace(key).first->second; }
+    V &at(const K &key)
+    {
+        iterator it = find(key);
+        if (it == end()) throw std::out_of_range("flat_map::at");
+        return it->second;
+    }
+    const V &at(const K &key) const
+    {
+        const_iterator it = find(key);
+        if (it == end()) throw std::out_of_range("flat_map::at");
+        return it->second;
+    }
+
+    // Backward-shift deletion: pull later members of the probe run into the hole
+    size_t erase(const K &key)
+    {
+        if (slots.empty()) return 0;
+        size_t i = probe(key);
+        if (!used[i]) return 0;
+        for (size_t j = (i + 1) & mask; used[j]; j = (j + 1) & mask)
+        {
+            size_t h = home(slots[j].first);
+            // Slot j may fill the hole at i only if its home is not within (i, j]
+            if (((j - h) & mask) >= ((j - i) & mask))
+            {
+                slots[i] = std::move(slots[j]);
+                i = j;
+            }
+        }
+        used[i] = 0;
+        slots[i] = value_type();
+        count_--;
+        return 1;
+    }
+    void erase(iterator it) { erase(it->first); }
+};
+
+template <class K, class Hash = anti_hack_hash>
+struct flat_set
+{
+    struct none {};
+    typedef flat_map<K, none, Hash> table;
+    typedef K key_type;
+    typedef K value_type;
+    table t;
+
+    struct iterator
+    {
+        typename table::const_iterator it;
+
+        const K &operator*() const { return it->first; }
+        const K *operator->() const { return &it->first; }
+        iterator &operator++()
+        {
+            ++it;
+            return *this;
+        }
+        bool operator==(const iterator &o) const { return it == o.it; }
+        bool operator!=(const iterator &o) const { return it != o.it; }
+    };
+    typedef iterator const_iterator;
+
+    flat_set() = default;
+    explicit flat_set(size_t n) : t(n) {}
+
+    size_t size() const { return t.size(); }
+    bool empty() const { return t.empty(); }
+    void clear() { t.clear(); }
+    void reserve(size_t n) { t.reserve(n); }
+    iterator begin() const { return iterator{t.begin()}; }
+    iterator end() const { return iterator{t.end()}; }
+    iterator find(const K &key) const { return iterator{t.find(key)}; }
+    size_t count(const K &key) const { return t.count(key); }
+    bool contains(const K &key) const { return t.contains(key); }
+    std::pair<iterator, bool> insert(const K &key)
+    {
+        std::pair<typename table::iterator, bool> r = t.try_emplace(key);
+        return {iterator{typename table::const_iterator{&t, r.first.i}}, r.second};
+    }
+    size_t erase(const K &key) { return t.erase(key); }
+};
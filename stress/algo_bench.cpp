@@ -0,0 +1,71 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <numeric>
+#include <random>
+#include <vector>
+#include "../algo.hpp"
+using namespace std;
+
+// algo.hpp routines against <algorithm>/<numeric> on random data
+// usage: algo_bench [n] [seed]      (stress/bench.sh builds it scalar, AVX2 and par_unseq)
+
+typedef chrono::steady_clock clk;
+
+template <class F>
+double best_ms(F f)
+{
+    double best = 1e18;
+    for (int rep = 0; rep < 5; rep++)
+    {
+        clk::time_point t0 = clk::now();
+        f();
+        best = min(best, chrono::duration<double, milli>(clk::now() - t0).count());
+    }
+    return best;
+}
+
+template <class T>
+void bench(const char *type, size_t n, mt19937_64 &rng)
+{
+    vector<T> a(n), b(n), out(n);
+    for (T &x : a) x = (T)rng();
+    long long check = 0;
+    printf("%s, n = %zu\n", type, n);
+
+    double s0 = best_ms([&] { b = a; sort(b.begin(), b.end()); });
+    double s1 = best_ms([&] { b = a; cp::radix_sort(b); });
+    check += b[n / 2];
+    printf("  sort          std %8.2f ms  toolkit %8.2f ms\n", s0, s1);
+
+    double p0 = best_ms([&] { partial_sum(a.begin(), a.end(), out.begin()); });
+    double p1 = best_ms([&] { cp::prefix_sum(a.data(), out.data(), n); });
+    check += out[n - 1];
+    printf("  prefix sum    std %8.2f ms  toolkit %8.2f ms\n", p0, p1);
+
+    double r0 = best_ms([&] { check += accumulate(a.begin(), a.end(), 0LL); });
+    double r1 = best_ms([&] { check += cp::sum(a); });
+    printf("  sum           std %8.2f ms  toolkit %8.2f ms\n", r0, r1);
+
+    double m0 = best_ms([&] { check += *min_element(a.begin(), a.end()) + *max_element(a.begin(), a.end()); });
+    double m1 = best_ms([&] { check += cp::min_value(a) + cp::max_value(a); });
+    printf("  min + max     std %8.2f ms  toolkit %8.2f ms  (check %lld)\n", m0, m1, check);
+}
+
+int main(int argc, char **argv)
+{
+    size_t n = argc > 1 ? strtoull(argv[1], nullptr, 10) : 10000000;
+    mt19937_64 rng(argc > 2 ? strtoull(argv[2], nullptr, 10) : 1);
+#ifdef CP_PAR_UNSEQ
+    const char *build = "par_unseq";
+#elif defined(__AVX2__)
+    const char *build = "AVX2";
+#else
+    const char *build = "scalar";
+#endif
+    printf("[%s build]\n", build);
+    bench<int>("int", max<size_t>(n, 1), rng);
+    bench<long long>("long long", max<size_t>(n, 1), rng);
+    return 0;
+}
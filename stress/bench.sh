@@ -0,0 +1,34 @@
+#!/usr/bin/env bash
+# Micro-benchmarks for the template's headers against the standard library.
+#
+#   stress/bench.sh [n]
+#
+# Builds stress/algo_bench.cpp scalar, with -mavx2 (when the CPU has it) and with
+# -DCP_PAR_UNSEQ (when <execution> links, via -ltbb on libstdc++), then runs
+# stress/hash_bench.cpp. CXX and CXXFLAGS are honoured.
+set -euo pipefail
+
+N=${1:-10000000}
+CXX=${CXX:-g++}
+CXXFLAGS=${CXXFLAGS:--O2}
+
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+WORK=$(mktemp -d)
+trap 'rm -rf "$WORK"' EXIT
+
+$CXX -std=c++17 $CXXFLAGS -o "$WORK/algo_scalar" "$ROOT/stress/algo_bench.cpp"
+"$WORK/algo_scalar" "$N"
+
+if grep -qw avx2 /proc/cpuinfo 2>/dev/null; then
+    $CXX -std=c++17 $CXXFLAGS -mavx2 -o "$WORK/algo_avx2" "$ROOT/stress/algo_bench.cpp"
+    "$WORK/algo_avx2" "$N"
+fi
+
+if $CXX -std=c++17 $CXXFLAGS -DCP_PAR_UNSEQ -o "$WORK/algo_par" "$ROOT/stress/algo_bench.cpp" -ltbb 2>/dev/null; then
+    "$WORK/algo_par" "$N"
+else
+    echo "[par_unseq build] skipped: <execution> needs TBB (-ltbb) here"
+fi
+
+$CXX -std=c++17 $CXXFLAGS -o "$WORK/hash_bench" "$ROOT/stress/hash_bench.cpp"
+"$WORK/hash_bench" "$(( N < 1000000 ? N : 1000000 ))"
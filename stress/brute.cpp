@@ -0,0 +1,22 @@
+#include <iostream>
+#include <vector>
+using namespace std;
+
+// Reference solution for the stress harness: plain iostream, obviously correct
+int main()
+{
+    ios_base::sync_with_stdio(false);
+    cin.tie(nullptr);
+    long long t;
+    cin >> t;
+    while (t--)
+    {
+        long long n;
+        cin >> n;
+        vector<long long> a(n);
+        for (long long i = 0; i < n; i++) cin >> a[i];
+        for (long long i = 0; i < n; i++) cout << a[i] << " ";
+        cout << "\n";
+    }
+    return 0;
+}
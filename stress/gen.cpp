@@ -0,0 +1,29 @@
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+using namespace std;
+
+// Random input in the code.cpp format: t, then n and a[0..n) per test case
+// usage: gen <t> <max_n> <max_abs> <seed>
+int main(int argc, char **argv)
+{
+    if (argc < 5)
+    {
+        fprintf(stderr, "usage: %s <t> <max_n> <max_abs> <seed>\n", argv[0]);
+        return 1;
+    }
+    long long t = atoll(argv[1]), max_n = atoll(argv[2]), max_abs = atoll(argv[3]);
+    mt19937_64 rng(strtoull(argv[4], nullptr, 10));
+    uniform_int_distribution<long long> len(1, max_n), val(-max_abs, max_abs);
+
+    static char buf[1 << 16];
+    setvbuf(stdout, buf, _IOFBF, sizeof(buf));
+    printf("%lld\n", t);
+    while (t--)
+    {
+        long long n = len(rng);
+        printf("%lld\n", n);
+        for (long long i = 0; i < n; i++) printf(i + 1 < n ? "%lld " : "%lld\n", val(rng));
+    }
+    return 0;
+}
@@ -0,0 +1,72 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <unordered_map>
+#include <vector>
+#include "../hashmap.hpp"
+using namespace std;
+
+// flat_map against std::unordered_map on random and anti-hash keys
+// usage: hash_bench [n] [seed]      (g++ -std=c++17 -O2 stress/hash_bench.cpp)
+
+typedef chrono::steady_clock clk;
+static double ms(clk::time_point a, clk::time_point b) { return chrono::duration<double, milli>(b - a).count(); }
+
+template <class Map>
+void run(const char *name, const vector<long long> &keys, const vector<long long> &lookups,
+         const vector<long long> &misses, bool reserve)
+{
+    Map m;
+    if (reserve) m.reserve(keys.size());
+    long long check = 0;
+    clk::time_point t0 = clk::now();
+    for (size_t i = 0; i < keys.size(); i++) m[keys[i]] += (long long)i;
+    clk::time_point t1 = clk::now();
+    for (long long k : lookups) check += m.find(k)->second;
+    clk::time_point t2 = clk::now();
+    for (long long k : misses) check += (long long)m.count(k);
+    clk::time_point t3 = clk::now();
+    for (size_t i = 0; i < keys.size(); i += 2) m.erase(keys[i]);
+    clk::time_point t4 = clk::now();
+    printf("  %-28s insert %8.1f  hit %8.1f  miss %8.1f  erase %8.1f ms  (size %zu, check %lld)\n", name,
+           ms(t0, t1), ms(t1, t2), ms(t2, t3), ms(t3, t4), m.size(), check);
+}
+
+// Hits are looked up in shuffled order so node-based maps get no help from allocation order
+void compare(const char *title, const vector<long long> &keys, const vector<long long> &misses, mt19937_64 &rng)
+{
+    vector<long long> lookups = keys;
+    shuffle(lookups.begin(), lookups.end(), rng);
+    printf("%s, %zu keys\n", title, keys.size());
+    run<unordered_map<long long, long long>>("unordered_map", keys, lookups, misses, false);
+    run<unordered_map<long long, long long>>("unordered_map + reserve", keys, lookups, misses, true);
+    run<flat_map<long long, long long>>("flat_map", keys, lookups, misses, false);
+    run<flat_map<long long, long long>>("flat_map + reserve", keys, lookups, misses, true);
+}
+
+int main(int argc, char **argv)
+{
+    size_t n = argc > 1 ? strtoull(argv[1], nullptr, 10) : 1000000;
+    mt19937_64 rng(argc > 2 ? strtoull(argv[2], nullptr, 10) : 1);
+
+    vector<long long> keys(n), misses(n);
+    for (size_t i = 0; i < n; i++) keys[i] = (long long)(rng() >> 1);
+    for (size_t i = 0; i < n; i++) misses[i] = -(long long)(rng() >> 1) - 1;
+    compare("random 63-bit keys", keys, misses, rng);
+
+    // Multiples of the bucket count a std::hash table ends up with all land in one bucket
+    // (std::hash is the identity on integers); kept small as unordered_map goes quadratic
+    size_t m = min<size_t>(n, 50000);
+    unordered_map<long long, long long> probe;
+    for (size_t i = 0; i < m; i++) probe[(long long)i];
+    long long prime = (long long)probe.bucket_count();
+    vector<long long> hack(m), hack_miss(m);
+    for (size_t i = 0; i < m; i++) hack[i] = (long long)(i + 1) * prime;
+    for (size_t i = 0; i < m; i++) hack_miss[i] = -(long long)(i + 1) * prime;
+    char title[64];
+    snprintf(title, sizeof(title), "anti-hash keys (multiples of %lld)", prime);
+    compare(title, hack, hack_miss, rng);
+    return 0;
+}
@@ -0,0 +1,49 @@
+#!/usr/bin/env bash
+# Stress test and benchmark for code.cpp against brute.cpp.
+#
+#   stress/stress.sh [iterations] [t] [max_n] [max_abs]
+#
+# Each iteration generates a random input.txt, runs the template and the
+# reference on it, diffs the outputs and reports the template's throughput.
+# CXX and CXXFLAGS are honoured (e.g. CXXFLAGS="-O2 -DCP_PROFILE").
+set -euo pipefail
+
+ITERS=${1:-5}
+T=${2:-1000}
+MAX_N=${3:-2000}
+MAX_ABS=${4:-1000000000000000000}
+CXX=${CXX:-g++}
+CXXFLAGS=${CXXFLAGS:--O2}
+
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+WORK=$(mktemp -d)
+trap 'rm -rf "$WORK"' EXIT
+
+$CXX -std=c++17 $CXXFLAGS -o "$WORK/code" "$ROOT/code.cpp"
+$CXX -std=c++17 -O2 -o "$WORK/gen" "$ROOT/stress/gen.cpp"
+$CXX -std=c++17 -O2 -o "$WORK/brute" "$ROOT/stress/brute.cpp"
+
+now() { date +%s.%N; }
+
+for ((it = 1; it <= ITERS; it++)); do
+    seed=$RANDOM$RANDOM
+    "$WORK/gen" "$T" "$MAX_N" "$MAX_ABS" "$seed" > "$WORK/input.txt"
+    tokens=$(wc -w < "$WORK/input.txt")
+    bytes=$(wc -c < "$WORK/input.txt")
+
+    start=$(now)
+    (cd "$WORK" && ./code)
+    end=$(now)
+    "$WORK/brute" < "$WORK/input.txt" > "$WORK/expected.txt"
+
+    if ! cmp -s "$WORK/output.txt" "$WORK/expected.txt"; then
+        cp "$WORK/input.txt" "$ROOT/stress/failing_input.txt"
+        echo "iteration $it (seed $seed): MISMATCH, input saved to stress/failing_input.txt"
+        exit 1
+    fi
+    awk -v it="$it" -v s="$start" -v e="$end" -v tok="$tokens" -v b="$bytes" 'BEGIN {
+        d = e - s; if (d <= 0) d = 1e-9;
+        printf "iteration %d: OK  %d tokens, %.1f MB in %.3f s  ->  %.2f Mtok/s, %.1f MB/s\n",
+               it, tok, b / 1e6, d, tok / d / 1e6, b / d / 1e6
+    }'
+done